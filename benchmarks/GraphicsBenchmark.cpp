@@ -0,0 +1,240 @@
+/**
+ * @file GraphicsBenchmark.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Compare the IGraphics backends on scrolling workloads
+ * @version 0.1
+ * @date 2019-06-07
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "spdlog/spdlog.h"
+#include "src/BitPlaneModulator.h"
+#include "src/FixedGraphics.h"
+#include "src/Font8x5.h"
+#include "src/GraphicsFactory.h"
+#include "src/GraphicsToolBox.h"
+#include "src/GrayscaleGraphics.h"
+#include "src/HorizontalGraphicsAnimation.h"
+#include "src/Ht1632Encoder.h"
+#include "src/NullSpiBus.h"
+#include "src/Sure3208LedMatrix.h"
+
+namespace {
+
+/**
+ * Width of the screen (two Sure 3208 panels).
+ */
+static const uint16_t SCREEN_WIDTH = 64;
+
+static const char MESSAGE[] =
+    "The quick brown fox jumps over the lazy dog. 0123456789 !?";
+
+/**
+ * Scroll the message over the screen \a repetitions times, reading the
+ * visible window after every step as the display thread does. Return the
+ * average duration of a step in nanoseconds.
+ */
+static double RunScrolling(ledmatrix::GraphicsFactory::GraphicsFactoryType type,
+                           ledmatrix::Direction direction,
+                           uint32_t repetitions) {
+  std::unique_ptr<ledmatrix::IGraphics> pGraphics =
+      ledmatrix::GraphicsFactory::CreateFactory(type)->GetIGraphics();
+  ledmatrix::Font8x5 font;
+  uint8_t window[SCREEN_WIDTH];
+  uint32_t checksum = 0;
+  uint64_t steps = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < repetitions; ++i) {
+    pGraphics->Clear();
+    ledmatrix::graphics_toolbox::WriteOnScreen(*pGraphics, font, MESSAGE);
+    ledmatrix::HorizontalGraphicsAnimation animation(*pGraphics, SCREEN_WIDTH,
+                                                     direction, 1);
+    while (!animation.IsAnimationDone()) {
+      animation.PerformStep();
+      pGraphics->ReadColumns(0, 0, window, SCREEN_WIDTH);
+      checksum += window[0] + window[SCREEN_WIDTH - 1];
+      ++steps;
+    }
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+
+  // Make sure that the compiler cannot drop the reads.
+  if (1 == checksum) {
+    std::cout << "";
+  }
+  return (std::chrono::duration<double, std::nano>(duration).count() / steps);
+}
+
+/**
+ * Encode the columns of a single panel \a iterations times, changing one
+ * column every time. Return the average duration of an encoding in
+ * nanoseconds.
+ */
+static double RunEncoding(void (*encode)(const uint8_t*, uint8_t*),
+                          uint32_t iterations) {
+  uint8_t columns[ledmatrix::ht1632_encoder::NUMBER_OF_COLUMNS] = {0};
+  uint8_t data[ledmatrix::ht1632_encoder::FRAME_SIZE];
+  uint32_t checksum = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < iterations; ++i) {
+    columns[i % ledmatrix::ht1632_encoder::NUMBER_OF_COLUMNS] =
+        static_cast<uint8_t>(i);
+    encode(columns, data);
+    checksum += data[1] + data[33];
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+
+  // Make sure that the compiler cannot drop the encoding.
+  if (1 == checksum) {
+    std::cout << "";
+  }
+  return (std::chrono::duration<double, std::nano>(duration).count() /
+          iterations);
+}
+
+/**
+ * Scroll the message over a row of \a numberOfPanels panels \a repetitions
+ * times, going through the whole display pipeline after every step: copy into
+ * a frame as the render thread does, then encode and send it with the Sure
+ * 3208 driver on a bus without any device. Return the average duration of a
+ * step in nanoseconds.
+ */
+static double RunDisplayPipeline(uint16_t numberOfPanels,
+                                 uint32_t repetitions) {
+  std::unique_ptr<ledmatrix::IGraphics> pGraphics =
+      ledmatrix::GraphicsFactory::CreateFactory(
+          ledmatrix::GraphicsFactory::MonoColor8RowsGraphicsFactoryType)
+          ->GetIGraphics();
+  ledmatrix::Font8x5 font;
+  ledmatrix::FixedGraphics<256, 8> frame;
+  ledmatrix::Sure3208LedMatrix hardware(
+      ledmatrix::panel_layout::CreateRow(numberOfPanels),
+      std::unique_ptr<ledmatrix::ISpiBus>(new ledmatrix::NullSpiBus()));
+  uint64_t steps = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < repetitions; ++i) {
+    pGraphics->Clear();
+    ledmatrix::graphics_toolbox::WriteOnScreen(*pGraphics, font, MESSAGE);
+    ledmatrix::HorizontalGraphicsAnimation animation(
+        *pGraphics, hardware.GetWidth(), ledmatrix::Left, 1);
+    while (!animation.IsAnimationDone()) {
+      animation.PerformStep();
+      frame.CopyFrom(*pGraphics);
+      pGraphics->ClearDirtyColumns();
+      hardware.WriteIGraphics(frame);
+      frame.ClearDirtyColumns();
+      ++steps;
+    }
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+  return (std::chrono::duration<double, std::nano>(duration).count() / steps);
+}
+
+/**
+ * Show a gradient scrolling over \a numberOfPanels panels \a repetitions times
+ * in grayscale: copy into a frame as the render thread does, then send every
+ * bit plane as the display thread does. Return the average duration of a
+ * sub-frame in nanoseconds.
+ */
+static double RunGrayscalePipeline(uint16_t numberOfPanels,
+                                   uint32_t repetitions) {
+  ledmatrix::GrayscaleGraphics<256, 8> graphics;
+  ledmatrix::GrayscaleGraphics<256, 8> frame;
+  ledmatrix::Sure3208LedMatrix hardware(
+      ledmatrix::panel_layout::CreateRow(numberOfPanels),
+      std::unique_ptr<ledmatrix::ISpiBus>(new ledmatrix::NullSpiBus()));
+  for (uint16_t x = 0; x < 256; ++x) {
+    for (uint16_t y = 0; y < 8; ++y) {
+      graphics.SetLevel(x, y, static_cast<uint8_t>((x + y) % 16));
+    }
+  }
+  const uint8_t numberOfSubFrames =
+      ledmatrix::bit_plane_modulator::NUMBER_OF_SUB_FRAMES;
+  uint64_t subFrames = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < repetitions; ++i) {
+    graphics.Shift(ledmatrix::Left, 1);
+    frame.CopyFrom(graphics);
+    for (uint8_t s = 0; s < numberOfSubFrames; ++s) {
+      ledmatrix::bit_plane_modulator::WriteSubFrame(hardware, frame, s, 15);
+      ++subFrames;
+    }
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+  return (std::chrono::duration<double, std::nano>(duration).count() /
+          subFrames);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  uint32_t repetitions = 200;
+  if (argc > 1) {
+    repetitions = strtoul(argv[1], NULL, 10);
+  }
+  spdlog::set_level(spdlog::level::warn);
+
+  const struct {
+    const char* name;
+    ledmatrix::GraphicsFactory::GraphicsFactoryType type;
+  } backends[] = {
+      {"MonoColor8RowsGraphics",
+       ledmatrix::GraphicsFactory::MonoColor8RowsGraphicsFactoryType},
+      {"BitPlaneGraphics",
+       ledmatrix::GraphicsFactory::BitPlaneGraphicsFactoryType},
+  };
+
+  std::cout << "Scrolling \"" << MESSAGE << "\" " << repetitions
+            << " times over " << SCREEN_WIDTH << " columns" << std::endl;
+  for (const auto& backend : backends) {
+    std::cout << backend.name << ": "
+              << RunScrolling(backend.type, ledmatrix::Left, repetitions)
+              << " ns/step (left), "
+              << RunScrolling(backend.type, ledmatrix::Right, repetitions)
+              << " ns/step (right)" << std::endl;
+  }
+
+  std::cout << "Encoding a panel: "
+            << RunEncoding(ledmatrix::ht1632_encoder::Encode,
+                           1000 * repetitions)
+            << " ns (Encode), "
+            << RunEncoding(ledmatrix::ht1632_encoder::EncodePortable,
+                           1000 * repetitions)
+            << " ns (EncodePortable), "
+            << RunEncoding(
+                   [](const uint8_t* columns, uint8_t* data) {
+                     ledmatrix::ht1632_encoder::EncodeScrolled(columns, 1,
+                                                               data);
+                   },
+                   1000 * repetitions)
+            << " ns (EncodeScrolled by 1 column)" << std::endl;
+
+  std::cout << "Display pipeline (NullSpiBus): "
+            << RunDisplayPipeline(2, repetitions) << " ns/step (2 panels), "
+            << RunDisplayPipeline(8, repetitions) << " ns/step (8 panels)"
+            << std::endl;
+
+  std::cout << "Grayscale pipeline (NullSpiBus): "
+            << RunGrayscalePipeline(2, 100 * repetitions)
+            << " ns/sub-frame (2 panels), "
+            << RunGrayscalePipeline(8, 100 * repetitions)
+            << " ns/sub-frame (8 panels)" << std::endl;
+  return (0);
+}
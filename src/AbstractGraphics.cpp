@@ -0,0 +1,68 @@
+/**
+ * @file AbstractGraphics.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Abstract graphics class (keeps track of the modifications)
+ * @version 0.1
+ * @date 2019-06-10
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+
+#include "src/AbstractGraphics.h"
+
+#include <algorithm>
+
+namespace ledmatrix {
+
+namespace {
+// 64 bits FNV-1a parameters
+const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+const uint64_t FNV_PRIME = 0x100000001b3ull;
+
+// Number of columns read at once while hashing.
+const uint16_t HASH_CHUNK_SIZE = 64;
+}  // namespace
+
+AbstractGraphics::AbstractGraphics()
+    : m_generation(0),
+      m_isOnlyShifted(false),
+      m_scrollHint(0),
+      m_contentHashGeneration(0),
+      m_contentHash(0) {
+  MarkAllDirty();
+}
+
+AbstractGraphics::~AbstractGraphics() {}
+
+uint64_t AbstractGraphics::GetContentHash() const {
+  if (m_contentHashGeneration == m_generation) {
+    return (m_contentHash);
+  }
+
+  uint64_t hash = FNV_OFFSET_BASIS;
+  uint8_t columns[HASH_CHUNK_SIZE];
+  uint16_t width = GetWidth();
+  uint16_t height = GetHeight();
+  // Hash the matrix by bands of 8 rows, using the column operations of the
+  // implementation.
+  for (uint16_t y = 0; y < height; y += 8) {
+    for (uint16_t x = 0; x < width; x += HASH_CHUNK_SIZE) {
+      uint16_t count = std::min<uint16_t>(HASH_CHUNK_SIZE, width - x);
+      ReadColumns(x, y, columns, count);
+      for (uint16_t i = 0; i < count; ++i) {
+        hash = (hash ^ columns[i]) * FNV_PRIME;
+      }
+    }
+  }
+
+  m_contentHash = hash;
+  m_contentHashGeneration = m_generation;
+  return (m_contentHash);
+}
+
+}  // namespace ledmatrix
@@ -0,0 +1,152 @@
+/**
+ * @file AbstractGraphics.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Abstract graphics class (keeps track of the modifications)
+ * @version 0.1
+ * @date 2019-06-09
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+
+#include "src/IGraphics.h"
+
+namespace ledmatrix {
+
+/**
+ * Base class for the IGraphics implementations. It keeps the range of screen
+ * columns modified since the last ClearDirtyColumns() and a generation
+ * counter: implementations call MarkDirty() from every operation changing the
+ * content of the screen. A new object is entirely dirty.
+ *
+ * The content hash is computed from ReadColumns() the first time it is
+ * requested for a given generation and cached until the next modification.
+ *
+ * Implementations call MarkShifted() instead of MarkAllDirty() when the
+ * content of the screen only moves, so that the consumers can reuse what they
+ * already have (see GetScrollHint()).
+ */
+class AbstractGraphics : public IGraphics {
+ public:
+  AbstractGraphics();
+  virtual ~AbstractGraphics();
+
+  // Prevent wrong usage of these operators.
+  AbstractGraphics(const AbstractGraphics& other) = delete;
+  AbstractGraphics& operator=(const AbstractGraphics& other) = delete;
+  AbstractGraphics(AbstractGraphics&& other) = delete;
+  AbstractGraphics& operator=(AbstractGraphics&& other) = delete;
+  bool operator==(const AbstractGraphics& other) const = delete;
+  bool operator!=(const AbstractGraphics& other) const = delete;
+
+  virtual ColumnRange GetDirtyColumns() const { return (m_dirtyColumns); }
+
+  virtual void ClearDirtyColumns() {
+    m_dirtyColumns.first = UINT16_MAX;
+    m_dirtyColumns.end = 0;
+    m_isOnlyShifted = true;
+    m_scrollHint = 0;
+  }
+
+  virtual int16_t GetScrollHint() const {
+    return (m_isOnlyShifted ? m_scrollHint : 0);
+  }
+
+  virtual uint32_t GetGeneration() const { return (m_generation); }
+  virtual uint64_t GetContentHash() const;
+
+ protected:
+  /**
+   * Add the \a count columns starting at \a x to the dirty range.
+   */
+  void MarkDirty(uint32_t x, uint32_t count) {
+    if ((0 == count) || (x >= UINT16_MAX)) {
+      return;
+    }
+    NextGeneration();
+    m_isOnlyShifted = false;
+    m_dirtyColumns.first = std::min<uint32_t>(m_dirtyColumns.first, x);
+    m_dirtyColumns.end =
+        std::max<uint32_t>(m_dirtyColumns.end,
+                           std::min<uint32_t>(x + count, UINT16_MAX));
+  }
+
+  /**
+   * Mark the whole screen as dirty, for operations moving every column.
+   */
+  void MarkAllDirty() {
+    NextGeneration();
+    m_isOnlyShifted = false;
+    m_dirtyColumns.first = 0;
+    m_dirtyColumns.end = UINT16_MAX;
+  }
+
+  /**
+   * Mark the whole screen as dirty after a shift of \a numberOfColumns in
+   * \a direction. Left and right shifts are added to the scroll hint.
+   */
+  void MarkShifted(Direction direction, uint16_t numberOfColumns) {
+    int32_t scrollHint = m_scrollHint;
+    if (Left == direction) {
+      scrollHint += numberOfColumns;
+    } else if (Right == direction) {
+      scrollHint -= numberOfColumns;
+    }
+    if (m_isOnlyShifted && ((Left == direction) || (Right == direction)) &&
+        (scrollHint > INT16_MIN) && (scrollHint < INT16_MAX)) {
+      MarkScrolled(static_cast<int16_t>(scrollHint));
+    } else {
+      MarkAllDirty();
+    }
+  }
+
+  /**
+   * Mark the whole screen as dirty, and set the scroll hint to \a scrollHint
+   * (0 if unknown).
+   */
+  void MarkScrolled(int16_t scrollHint) {
+    MarkAllDirty();
+    m_isOnlyShifted = (0 != scrollHint);
+    m_scrollHint = scrollHint;
+  }
+
+ private:
+  ColumnRange m_dirtyColumns;
+  uint32_t m_generation;
+
+  /**
+   * True if nothing but shifts happened since the last ClearDirtyColumns().
+   */
+  bool m_isOnlyShifted;
+  /**
+   * Number of columns the screen moved to the left (negative if it moved to
+   * the right) since the last ClearDirtyColumns().
+   */
+  int16_t m_scrollHint;
+
+  /**
+   * Generation for which m_contentHash was computed (0 if never computed).
+   */
+  mutable uint32_t m_contentHashGeneration;
+  mutable uint64_t m_contentHash;
+
+  /**
+   * Increment the generation, skipping 0 (reserved for untracked objects).
+   */
+  void NextGeneration() {
+    if (0 == ++m_generation) {
+      m_generation = 1;
+    }
+  }
+};
+
+}  // namespace ledmatrix
@@ -0,0 +1,183 @@
+/**
+ * @file AsyncSpiBus.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief SPI transport sending the messages from a dedicated thread
+ * @version 0.1
+ * @date 2019-06-14
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+
+#include "src/AsyncSpiBus.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <string.h>
+
+#include <utility>
+
+#include "spdlog/spdlog.h"
+
+namespace ledmatrix {
+
+const uint16_t AsyncSpiBus::NUMBER_OF_SLOTS;
+const uint16_t AsyncSpiBus::MAX_PENDING_SLOTS_FOR_FRAMES;
+const uint16_t AsyncSpiBus::MAX_TRANSFERS_PER_SLOT;
+const uint16_t AsyncSpiBus::MAX_BYTES_PER_SLOT;
+
+AsyncSpiBus::AsyncSpiBus(std::unique_ptr<ISpiBus> pSpiBus)
+    : m_pSpiBus(std::move(pSpiBus)),
+      m_numberOfDroppedBatches(0),
+      m_bRun(true) {
+  if (0 != sem_init(&m_queuedSlots, 0, 0)) {
+    spdlog::error("Failed to sem_init: {}", strerror(errno));
+  }
+  m_writerThread = std::thread(&AsyncSpiBus::WriterTask, this);
+  pthread_setname_np(m_writerThread.native_handle(), "AsyncSpiBus");
+
+  // The writer thread feeds the display: it runs "real time" as well, just
+  // below the display thread.
+  sched_param sch;
+  int policy;
+  pthread_getschedparam(m_writerThread.native_handle(), &policy, &sch);
+  sch.sched_priority = 98;
+  if (pthread_setschedparam(m_writerThread.native_handle(), SCHED_FIFO,
+                            &sch)) {
+    spdlog::error("Failed to setschedparam: {}", strerror(errno));
+  }
+}
+
+AsyncSpiBus::~AsyncSpiBus() {
+  m_bRun.store(false, std::memory_order_release);
+  sem_post(&m_queuedSlots);
+  if (m_writerThread.joinable()) {
+    m_writerThread.join();
+  }
+  sem_destroy(&m_queuedSlots);
+}
+
+bool AsyncSpiBus::Setup(int channel) {
+  Flush();
+  return (m_pSpiBus->Setup(channel));
+}
+
+int AsyncSpiBus::GetNumberOfChannels() const {
+  return (m_pSpiBus->GetNumberOfChannels());
+}
+
+uint32_t AsyncSpiBus::GetSpeedHz() const {
+  return (m_pSpiBus->GetSpeedHz());
+}
+
+bool AsyncSpiBus::WriteBatch(const SpiTransfer* transfers, uint16_t count) {
+  return (Enqueue(transfers, count, false));
+}
+
+bool AsyncSpiBus::TryWriteBatch(const SpiTransfer* transfers, uint16_t count) {
+  return (Enqueue(transfers, count, true));
+}
+
+void AsyncSpiBus::Flush() {
+  // A slot is popped once it has been sent.
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_condition.wait(lock, [this] { return (m_slots.IsEmpty()); });
+}
+
+bool AsyncSpiBus::Enqueue(const SpiTransfer* transfers, uint16_t count,
+                          bool canDrop) {
+  uint16_t numberOfSlots = CountSlots(transfers, count);
+  if ((0 == numberOfSlots) && (count > 0)) {
+    spdlog::error("SPI message too large for the queue, dropped.");
+    return (false);
+  }
+  // The free slots can only grow until we push: checking once is enough. A
+  // frame queued behind several others would reach the screen late, the
+  // next one is sent instead.
+  uint16_t freeSlots = m_slots.GetFreeSlots();
+  uint16_t pendingSlots = static_cast<uint16_t>(NUMBER_OF_SLOTS - freeSlots);
+  if (canDrop && ((freeSlots < numberOfSlots) ||
+                  (pendingSlots > MAX_PENDING_SLOTS_FOR_FRAMES))) {
+    m_numberOfDroppedBatches.fetch_add(1, std::memory_order_relaxed);
+    return (false);
+  }
+
+  uint16_t i = 0;
+  while (i < count) {
+    // Never spin here: the writer thread may have a lower priority.
+    Slot* pSlot = m_slots.GetWriteSlot();
+    if (NULL == pSlot) {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock, [this] { return (0 != m_slots.GetFreeSlots()); });
+      pSlot = m_slots.GetWriteSlot();
+    }
+
+    uint16_t size = 0;
+    pSlot->count = 0;
+    while ((i < count) && (pSlot->count < MAX_TRANSFERS_PER_SLOT) &&
+           (size + transfers[i].size <= MAX_BYTES_PER_SLOT)) {
+      SpiTransfer& transfer = pSlot->transfers[pSlot->count];
+      memcpy(pSlot->data + size, transfers[i].data, transfers[i].size);
+      transfer.channel = transfers[i].channel;
+      transfer.data = pSlot->data + size;
+      transfer.size = transfers[i].size;
+      size += transfers[i].size;
+      ++pSlot->count;
+      ++i;
+    }
+    m_slots.Push();
+    sem_post(&m_queuedSlots);
+  }
+  return (true);
+}
+
+uint16_t AsyncSpiBus::CountSlots(const SpiTransfer* transfers,
+                                 uint16_t count) {
+  uint16_t numberOfSlots = 0;
+  uint16_t numberOfTransfers = MAX_TRANSFERS_PER_SLOT;
+  uint16_t size = MAX_BYTES_PER_SLOT;
+  for (uint16_t i = 0; i < count; ++i) {
+    if (transfers[i].size > MAX_BYTES_PER_SLOT) {
+      return (0);
+    }
+    if ((numberOfTransfers == MAX_TRANSFERS_PER_SLOT) ||
+        (size + transfers[i].size > MAX_BYTES_PER_SLOT)) {
+      ++numberOfSlots;
+      numberOfTransfers = 0;
+      size = 0;
+    }
+    ++numberOfTransfers;
+    size += transfers[i].size;
+  }
+  return (numberOfSlots);
+}
+
+void AsyncSpiBus::WriterTask() {
+  while (true) {
+    while ((0 != sem_wait(&m_queuedSlots)) && (EINTR == errno)) {
+    }
+    // Every pushed slot is posted once. The queued messages are sent before
+    // stopping: the last post, without any slot, stops the thread.
+    Slot* pSlot = m_slots.GetReadSlot();
+    if (NULL == pSlot) {
+      if (!m_bRun.load(std::memory_order_acquire)) {
+        break;
+      }
+      continue;
+    }
+
+    m_pSpiBus->WriteBatch(pSlot->transfers, pSlot->count);
+    m_slots.Pop();
+
+    // Wake up the caller if it waits for some room or for the queue to be
+    // empty.
+    { std::lock_guard<std::mutex> guard(m_mutex); }
+    m_condition.notify_all();
+  }
+}
+
+}  // namespace ledmatrix
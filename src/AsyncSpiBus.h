@@ -0,0 +1,154 @@
+/**
+ * @file AsyncSpiBus.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief SPI transport sending the messages from a dedicated thread
+ * @version 0.1
+ * @date 2019-06-14
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <semaphore.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "src/ISpiBus.h"
+#include "src/SpscRingBuffer.h"
+
+namespace ledmatrix {
+
+/**
+ * Queue the messages and send them on another bus from a writer thread, so
+ * that the caller does not wait for the bus.
+ *
+ * The messages are copied into a bounded queue. WriteBatch() waits for some
+ * room in the queue when it is full, while TryWriteBatch() drops the messages
+ * and returns false as soon as another frame waits behind the one being sent
+ * (see MAX_PENDING_SLOTS_FOR_FRAMES): when the bus falls behind, the screen
+ * never lags more than one frame. The caller then sends its whole screen
+ * again, with the next frame or with the same one when nothing changes (see
+ * ILedMatrixDriver::IsFrameDropped()), so that the latest frame always ends
+ * up on the screen.
+ *
+ * Only one thread may write on an AsyncSpiBus.
+ */
+class AsyncSpiBus : public ISpiBus {
+ public:
+  /**
+   * Constructor. Start the writer thread.
+   * @param pSpiBus the bus the messages are sent on.
+   */
+  explicit AsyncSpiBus(std::unique_ptr<ISpiBus> pSpiBus);
+
+  /**
+   * Destructor. Send the queued messages and stop the writer thread.
+   */
+  virtual ~AsyncSpiBus();
+
+  // Prevent wrong usage of these operators.
+  AsyncSpiBus() = delete;
+  AsyncSpiBus(const AsyncSpiBus& other) = delete;
+  AsyncSpiBus& operator=(const AsyncSpiBus& other) = delete;
+  AsyncSpiBus(AsyncSpiBus&& other) = delete;
+  AsyncSpiBus& operator=(AsyncSpiBus&& other) = delete;
+  bool operator==(const AsyncSpiBus& other) const = delete;
+  bool operator!=(const AsyncSpiBus& other) const = delete;
+
+  /**
+   * Wait for the queued messages to be sent, then set the channel up.
+   */
+  virtual bool Setup(int channel);
+  virtual int GetNumberOfChannels() const;
+  virtual uint32_t GetSpeedHz() const;
+  virtual bool WriteBatch(const SpiTransfer* transfers, uint16_t count);
+  virtual bool TryWriteBatch(const SpiTransfer* transfers, uint16_t count);
+
+  /**
+   * Wait for the queued messages to be sent.
+   */
+  void Flush();
+
+  /**
+   * @return the number of batches dropped by TryWriteBatch() so far.
+   */
+  uint32_t GetNumberOfDroppedBatches() const {
+    return (m_numberOfDroppedBatches.load(std::memory_order_relaxed));
+  }
+
+  /**
+   * Size of the queue. Larger batches use several slots.
+   */
+  static const uint16_t NUMBER_OF_SLOTS = 8;
+  /**
+   * TryWriteBatch() drops the messages when more slots than this are not sent
+   * yet, the one being sent included.
+   */
+  static const uint16_t MAX_PENDING_SLOTS_FOR_FRAMES = 1;
+  static const uint16_t MAX_TRANSFERS_PER_SLOT = 64;
+  static const uint16_t MAX_BYTES_PER_SLOT = 2176;
+
+ private:
+  /**
+   * Messages sent with a single call to the other bus.
+   */
+  struct Slot {
+    uint16_t count;
+    SpiTransfer transfers[MAX_TRANSFERS_PER_SLOT];
+    uint8_t data[MAX_BYTES_PER_SLOT];
+  };
+
+  std::unique_ptr<ISpiBus> m_pSpiBus;
+  SpscRingBuffer<Slot, NUMBER_OF_SLOTS> m_slots;
+  std::atomic<uint32_t> m_numberOfDroppedBatches;
+
+  /**
+   * Number of slots pushed and not sent yet, plus one once the writer thread
+   * must stop. The writer thread sleeps on it when the queue is empty. The
+   * caller posts it without taking any lock: queuing a frame never waits for
+   * the writer thread.
+   */
+  sem_t m_queuedSlots;
+  std::atomic<bool> m_bRun;
+
+  /**
+   * Only used to put the caller to sleep when it waits for the writer
+   * thread, for some room in the queue or for the queue to be empty.
+   */
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+
+  std::thread m_writerThread;
+
+  /**
+   * Copy the messages into the queue.
+   * @param transfers the messages to queue.
+   * @param count number of messages.
+   * @param canDrop if true, the messages are dropped when they do not fit in
+   * the queue. Otherwise, wait for the writer thread to make some room.
+   * @return true if the messages were queued.
+   */
+  bool Enqueue(const SpiTransfer* transfers, uint16_t count, bool canDrop);
+
+  /**
+   * Number of slots needed to queue some messages.
+   * @param transfers the messages to queue.
+   * @param count number of messages.
+   * @return the number of slots, 0 if a message is too large for a slot.
+   */
+  static uint16_t CountSlots(const SpiTransfer* transfers, uint16_t count);
+
+  void WriterTask();
+};
+
+}  // namespace ledmatrix
@@ -0,0 +1,392 @@
+/**
+ * @file BitPlaneGraphics.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Single color 8 rows Led Matrix stored row by row
+ * @version 0.1
+ * @date 2019-06-07
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+
+#include "src/BitPlaneGraphics.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "spdlog/spdlog.h"
+
+namespace {
+
+static const uint32_t BITS_PER_WORD = 64;
+
+/**
+ * Return the number of words needed to store \a columns bits.
+ */
+static uint32_t GetNumberOfWords(uint32_t columns) {
+  return ((columns + BITS_PER_WORD - 1) / BITS_PER_WORD);
+}
+
+/**
+ * Move every bit of \a row \a bits columns to the left (towards the column
+ * 0). The bits moved before the column 0 are lost.
+ */
+static void ShiftRowLeft(std::vector<uint64_t>& row, uint32_t bits) {
+  uint32_t words = bits / BITS_PER_WORD;
+  uint32_t offset = bits % BITS_PER_WORD;
+  size_t size = row.size();
+  for (size_t i = 0; i < size; ++i) {
+    uint64_t low = (i + words < size) ? row[i + words] : 0;
+    if (0 == offset) {
+      row[i] = low;
+    } else {
+      uint64_t high = (i + words + 1 < size) ? row[i + words + 1] : 0;
+      row[i] = (low >> offset) | (high << (BITS_PER_WORD - offset));
+    }
+  }
+}
+
+/**
+ * Move every bit of \a row \a bits columns to the right. The bits moved after
+ * the last word are lost.
+ */
+static void ShiftRowRight(std::vector<uint64_t>& row, uint32_t bits) {
+  uint32_t words = bits / BITS_PER_WORD;
+  uint32_t offset = bits % BITS_PER_WORD;
+  for (size_t i = row.size(); i-- > 0;) {
+    uint64_t high = (i >= words) ? row[i - words] : 0;
+    if (0 == offset) {
+      row[i] = high;
+    } else {
+      uint64_t low = (i >= words + 1) ? row[i - words - 1] : 0;
+      row[i] = (high << offset) | (low >> (BITS_PER_WORD - offset));
+    }
+  }
+}
+
+/**
+ * Return the 64 bits of \a row starting at column \a position. The bits after
+ * the last word are 0.
+ */
+static uint64_t GetBits(const std::vector<uint64_t>& row, uint32_t position) {
+  uint32_t word = position / BITS_PER_WORD;
+  uint32_t offset = position % BITS_PER_WORD;
+  if (word >= row.size()) {
+    return (0);
+  }
+  uint64_t result = row[word] >> offset;
+  if ((0 != offset) && (word + 1 < row.size())) {
+    result |= row[word + 1] << (BITS_PER_WORD - offset);
+  }
+  return (result);
+}
+
+/**
+ * Replace the \a count bits (at most 64) of \a row starting at column
+ * \a position by the lowest bits of \a value.
+ */
+static void SetBits(std::vector<uint64_t>& row, uint32_t position,
+                    uint32_t count, uint64_t value) {
+  uint32_t word = position / BITS_PER_WORD;
+  uint32_t offset = position % BITS_PER_WORD;
+  uint64_t mask =
+      (count >= BITS_PER_WORD) ? ~uint64_t(0) : ((uint64_t(1) << count) - 1);
+  value &= mask;
+  row[word] = (row[word] & ~(mask << offset)) | (value << offset);
+  if (offset + count > BITS_PER_WORD) {
+    uint32_t shift = BITS_PER_WORD - offset;
+    row[word + 1] = (row[word + 1] & ~(mask >> shift)) | (value >> shift);
+  }
+}
+
+/**
+ * Set (or clear) the \a count bits of \a row starting at column \a position.
+ */
+static void FillBits(std::vector<uint64_t>& row, uint32_t position,
+                     uint32_t count, bool on) {
+  while (0 != count) {
+    uint32_t bits = std::min<uint32_t>(
+        count, BITS_PER_WORD - (position % BITS_PER_WORD));
+    SetBits(row, position, bits, on ? ~uint64_t(0) : 0);
+    position += bits;
+    count -= bits;
+  }
+}
+
+/**
+ * Transpose a 8x8 bit matrix: bit j of byte i becomes bit i of byte j. This
+ * turns 8 packed columns into 8 bytes of rows, and vice versa.
+ */
+static uint64_t Transpose8x8(uint64_t x) {
+  uint64_t t;
+  t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+  x = x ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+  x = x ^ t ^ (t << 14);
+  t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+  x = x ^ t ^ (t << 28);
+  return (x);
+}
+
+}  // namespace
+
+namespace ledmatrix {
+
+BitPlaneGraphics::BitPlaneGraphics() : m_size(0), m_screenOriginPosition(0) {}
+
+BitPlaneGraphics::~BitPlaneGraphics() {}
+
+void BitPlaneGraphics::SetPixel(uint16_t x, uint16_t y, bool on) {
+  uint32_t position = x + m_screenOriginPosition;
+  if (y >= BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS) {
+    /*  We are outside of the bounds. That is ok, we just ignore the call
+            and log a message. */
+    spdlog::error(
+        "Tried to set a pixel outside of the bound (at ({}, {}) with a matrix "
+        "of size {}x{}.",
+        position, y, GetWidth(), GetHeight());
+    return;
+  }
+
+  // Increase the size of our matrix in case we are outside the x boundaries
+  if (position >= m_size) {
+    Grow(x + 1);
+    position = x + m_screenOriginPosition;
+  }
+
+  MarkDirty(x, 1);
+  uint64_t& word = m_rows[y][position / BITS_PER_WORD];
+  uint64_t bit = uint64_t(1) << (position % BITS_PER_WORD);
+  if (on) {
+    word |= bit;
+  } else {
+    word &= ~bit;
+  }
+}
+
+bool BitPlaneGraphics::GetPixel(uint16_t x, uint16_t y) const {
+  uint32_t position = x + m_screenOriginPosition;
+  // Everything outside of the bounds is considered as not set
+  if ((position >= m_size) || (y >= BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS)) {
+    return (false);
+  }
+  return (0 != ((m_rows[y][position / BITS_PER_WORD] >>
+                 (position % BITS_PER_WORD)) &
+                0x1));
+}
+
+void BitPlaneGraphics::WriteColumns(uint16_t x, uint16_t y,
+                                    const uint8_t* columns, uint16_t count) {
+  if ((0 == count) || (y >= BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS)) {
+    return;
+  }
+  if (x + count + m_screenOriginPosition > m_size) {
+    Grow(x + count);
+  }
+  MarkDirty(x, count);
+
+  // The columns are handled 8 by 8: a block of 8 packed columns is turned
+  // into 8 bytes of rows, which are then inserted in their bit string.
+  uint32_t position = x + m_screenOriginPosition;
+  for (uint16_t i = 0; i < count; i += 8) {
+    uint32_t blockSize = std::min<uint32_t>(8, count - i);
+    uint64_t block = 0;
+    for (uint32_t j = 0; j < blockSize; ++j) {
+      block |= uint64_t(columns[i + j]) << (8 * j);
+    }
+    block = Transpose8x8(block);
+    for (uint16_t row = y; row < BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS; ++row) {
+      SetBits(m_rows[row], position + i, blockSize,
+              (block >> (8 * (row - y))) & 0xFF);
+    }
+  }
+}
+
+void BitPlaneGraphics::ReadColumns(uint16_t x, uint16_t y, uint8_t* columns,
+                                   uint16_t count) const {
+  uint32_t position = x + m_screenOriginPosition;
+  uint16_t available = 0;
+  if ((position < m_size) && (y < BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS)) {
+    available = std::min<uint32_t>(count, m_size - position);
+    // Each row is read 64 columns at a time, then every block of 8 columns is
+    // turned back into 8 packed columns.
+    uint64_t rows[BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS] = {0};
+    for (uint16_t i = 0; i < available; i += 8) {
+      if (0 == (i % BITS_PER_WORD)) {
+        for (uint16_t row = y; row < BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS; ++row) {
+          rows[row] = GetBits(m_rows[row], position + i);
+        }
+      }
+      uint32_t shift = i % BITS_PER_WORD;
+      uint64_t block = 0;
+      for (uint16_t row = y; row < BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS; ++row) {
+        block |= ((rows[row] >> shift) & 0xFF) << (8 * (row - y));
+      }
+      block = Transpose8x8(block);
+      uint32_t blockSize = std::min<uint32_t>(8, available - i);
+      for (uint32_t j = 0; j < blockSize; ++j) {
+        columns[i + j] = static_cast<uint8_t>(block >> (8 * j));
+      }
+    }
+  }
+  // Everything outside of the bounds is considered as not set
+  memset(columns + available, 0, count - available);
+}
+
+void BitPlaneGraphics::FillColumns(uint16_t x, uint16_t y, uint16_t count,
+                                   uint8_t column) {
+  if ((0 == count) || (y >= BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS)) {
+    return;
+  }
+  if (x + count + m_screenOriginPosition > m_size) {
+    Grow(x + count);
+  }
+  MarkDirty(x, count);
+
+  uint32_t position = x + m_screenOriginPosition;
+  for (uint16_t row = y; row < BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS; ++row) {
+    FillBits(m_rows[row], position, count,
+             0 != ((column >> (row - y)) & 0x1));
+  }
+}
+
+uint16_t BitPlaneGraphics::GetHeight() const {
+  return (BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS);
+}
+
+uint16_t BitPlaneGraphics::GetWidth() const {
+  return (std::min<uint32_t>(m_size - m_screenOriginPosition, UINT16_MAX));
+}
+
+void BitPlaneGraphics::SetWidth(uint16_t width) {
+  if (m_size < width + m_screenOriginPosition) {
+    Grow(width);
+  }
+}
+
+void BitPlaneGraphics::Clear() {
+  // The storage is kept, so that the next message does not reallocate it.
+  Reset();
+  m_size = 0;
+}
+
+void BitPlaneGraphics::Reset() {
+  MarkAllDirty();
+  for (std::vector<uint64_t>& row : m_rows) {
+    std::fill(row.begin(), row.end(), 0);
+  }
+  m_screenOriginPosition = 0;
+}
+
+void BitPlaneGraphics::Rotate(Direction direction, uint16_t numberOfRows) {
+  MarkAllDirty();
+  if ((Right == direction) || (Left == direction)) {
+    if ((0 != numberOfRows) && (m_size != 0)) {
+      uint32_t offset = numberOfRows % m_size;
+      if (Right == direction) {
+        offset = (m_size - offset) % m_size;
+      }
+      if (0 != offset) {
+        // A rotation is the union of the row shifted to the left and the
+        // columns that went out, shifted to the right of the stored columns.
+        std::vector<uint64_t> wrapped;
+        uint32_t capacity = m_rows[0].size() * BITS_PER_WORD;
+        for (std::vector<uint64_t>& row : m_rows) {
+          wrapped = row;
+          ShiftRowLeft(row, offset);
+          ShiftRowRight(wrapped, m_size - offset);
+          for (size_t i = 0; i < row.size(); ++i) {
+            row[i] |= wrapped[i];
+          }
+          FillBits(row, m_size, capacity - m_size, false);
+        }
+      }
+    }
+  } else if ((Up == direction) || (Down == direction)) {
+    // Moving the pixels vertically only moves whole rows.
+    uint16_t moved = std::min<uint16_t>(numberOfRows,
+                                        BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS);
+    uint16_t kept = BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS - moved;
+    if (Up == direction) {
+      for (uint16_t y = BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS; y-- > moved;) {
+        m_rows[y] = m_rows[y - moved];
+      }
+      for (uint16_t y = 0; y < moved; ++y) {
+        std::fill(m_rows[y].begin(), m_rows[y].end(), 0);
+      }
+    } else {
+      for (uint16_t y = 0; y < kept; ++y) {
+        m_rows[y] = m_rows[y + moved];
+      }
+      for (uint16_t y = kept; y < BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS; ++y) {
+        std::fill(m_rows[y].begin(), m_rows[y].end(), 0);
+      }
+    }
+  }
+}
+
+void BitPlaneGraphics::Shift(Direction direction, uint16_t numberOfRows) {
+  if (0 == m_size) {
+    spdlog::error("Trying to shift a led matrix of size 0.");
+    return;
+  }
+  if (0 != numberOfRows) {
+    MarkShifted(direction, numberOfRows);
+    spdlog::debug("Shifting {} rows to the {}", numberOfRows,
+                  direction == Left ? "left" : "right");
+    if (Right == direction) {
+      // First bring back the columns that were shifted out, then shift every
+      // row to make room for the missing blank columns.
+      uint32_t restored =
+          std::min<uint32_t>(m_screenOriginPosition, numberOfRows);
+      m_screenOriginPosition -= restored;
+      uint32_t added = numberOfRows - restored;
+      if (0 != added) {
+        Reserve(m_size + added);
+        for (std::vector<uint64_t>& row : m_rows) {
+          ShiftRowRight(row, added);
+        }
+        m_size += added;
+      }
+    } else {
+      // Shifting past the last column leaves an empty matrix.
+      m_screenOriginPosition =
+          std::min(m_screenOriginPosition + numberOfRows, m_size);
+    }
+  }
+  spdlog::debug("New size after shift: {}", GetWidth());
+  spdlog::debug("New origin position after shift: {}", m_screenOriginPosition);
+}
+
+void BitPlaneGraphics::Reserve(uint32_t capacity) {
+  uint32_t words = GetNumberOfWords(capacity);
+  if (m_rows[0].size() < words) {
+    // Grow geometrically so that adding columns one by one stays cheap.
+    words = std::max<uint32_t>(words, 2 * m_rows[0].size());
+    for (std::vector<uint64_t>& row : m_rows) {
+      row.resize(words, 0);
+    }
+  }
+}
+
+void BitPlaneGraphics::Grow(uint32_t width) {
+  // The columns that were shifted out on the left are dropped before growing,
+  // so that an endless scrolling does not grow forever.
+  if (0 != m_screenOriginPosition) {
+    for (std::vector<uint64_t>& row : m_rows) {
+      ShiftRowLeft(row, m_screenOriginPosition);
+    }
+    m_size -= m_screenOriginPosition;
+    m_screenOriginPosition = 0;
+  }
+
+  Reserve(width);
+  m_size = width;
+}
+
+}  // namespace ledmatrix
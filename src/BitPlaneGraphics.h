@@ -0,0 +1,107 @@
+/**
+ * @file BitPlaneGraphics.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Single color 8 rows Led Matrix stored row by row
+ * @version 0.1
+ * @date 2019-06-07
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <vector>
+
+#include "src/AbstractGraphics.h"
+
+/**
+ * The number of rows (bit planes) of the matrix.
+ */
+#define BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS 8
+
+namespace ledmatrix {
+
+/**
+ * Represent a single color 8 rows Led Matrix where every row is stored as a
+ * bit string of 64 bits words (bit x % 64 of word x / 64 is the pixel at
+ * column x). This layout is meant for scrolling: moving the whole image by
+ * any number of columns is one multi-word shift per row, and a shift to the
+ * left only moves the screen origin.
+ *
+ * Columns shifted out on the left are kept (a shift to the right brings them
+ * back) until the matrix has to grow on the right. They are then dropped by
+ * shifting every row.
+ */
+class BitPlaneGraphics : public AbstractGraphics {
+ public:
+  BitPlaneGraphics();
+  virtual ~BitPlaneGraphics();
+
+  // Prevent wrong usage of these operators.
+  BitPlaneGraphics(const BitPlaneGraphics& other) = delete;
+  BitPlaneGraphics& operator=(const BitPlaneGraphics& other) = delete;
+  BitPlaneGraphics(BitPlaneGraphics&& other) = delete;
+  BitPlaneGraphics& operator=(BitPlaneGraphics&& other) = delete;
+  bool operator==(const BitPlaneGraphics& other) const = delete;
+  bool operator!=(const BitPlaneGraphics& other) const = delete;
+
+  /* Pixel operations */
+  virtual void SetPixel(uint16_t x, uint16_t y, bool on);
+  virtual bool GetPixel(uint16_t x, uint16_t y) const;
+
+  /* Column operations */
+  virtual void WriteColumns(uint16_t x, uint16_t y, const uint8_t* columns,
+                            uint16_t count);
+  virtual void ReadColumns(uint16_t x, uint16_t y, uint8_t* columns,
+                           uint16_t count) const;
+  virtual void FillColumns(uint16_t x, uint16_t y, uint16_t count,
+                           uint8_t column);
+
+  /* Full matrix operations */
+  virtual uint16_t GetHeight() const;
+  virtual uint16_t GetWidth() const;
+  virtual void SetWidth(uint16_t width);
+
+  virtual void Clear();
+  virtual void Reset();
+  virtual void Rotate(Direction direction, uint16_t numberOfRows);
+  virtual void Shift(Direction direction, uint16_t numberOfRows);
+
+ private:
+  /**
+   * One bit string per row. All the rows have the same number of words and
+   * the bits after the last stored column are always 0.
+   */
+  std::array<std::vector<uint64_t>, BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS> m_rows;
+  /**
+   * Number of stored columns (including the ones before the screen origin).
+   */
+  uint32_t m_size;
+  /**
+   * Number of stored columns that were shifted out on the left of the screen.
+   */
+  uint32_t m_screenOriginPosition;
+
+  /**
+   * Make sure that every row can hold at least \a capacity columns.
+   * @param capacity minimal number of columns.
+   */
+  void Reserve(uint32_t capacity);
+
+  /**
+   * Increase the width of the matrix to \a width, adding blank columns on the
+   * right. The columns that were shifted out on the left of the screen are
+   * dropped first, which resets the screen origin to 0.
+   * @param width new width of the matrix.
+   */
+  void Grow(uint32_t width);
+};
+
+}  // namespace ledmatrix
@@ -0,0 +1,27 @@
+/**
+ * @file BitPlaneGraphicsFactory.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Factory for BitPlaneGraphics classes
+ * @version 0.1
+ * @date 2019-06-07
+ * 
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com). All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ */
+#include "src/BitPlaneGraphicsFactory.h"
+#include "src/BitPlaneGraphics.h"
+
+namespace ledmatrix {
+
+BitPlaneGraphicsFactory::BitPlaneGraphicsFactory() {}
+
+BitPlaneGraphicsFactory::~BitPlaneGraphicsFactory() {}
+
+std::unique_ptr<IGraphics> BitPlaneGraphicsFactory::GetIGraphics() {
+  return (std::unique_ptr<IGraphics>(new BitPlaneGraphics()));
+}
+
+}  // namespace ledmatrix
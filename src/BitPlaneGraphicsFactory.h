@@ -0,0 +1,46 @@
+/**
+ * @file BitPlaneGraphicsFactory.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Factory for BitPlaneGraphics classes
+ * @version 0.1
+ * @date 2019-06-07
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+
+#pragma once
+
+#include "GraphicsFactory.h"
+
+#include <memory>
+
+namespace ledmatrix {
+
+/**
+ * Factory for BitPlaneGraphics class
+ */
+class BitPlaneGraphicsFactory : public GraphicsFactory {
+ public:
+  BitPlaneGraphicsFactory();
+  virtual ~BitPlaneGraphicsFactory();
+
+  // Prevent wrong usage of these operators.
+  BitPlaneGraphicsFactory(const BitPlaneGraphicsFactory& other) =
+      delete;
+  BitPlaneGraphicsFactory& operator=(
+      const BitPlaneGraphicsFactory& other) = delete;
+  BitPlaneGraphicsFactory(BitPlaneGraphicsFactory&& other) = delete;
+  BitPlaneGraphicsFactory& operator=(
+      BitPlaneGraphicsFactory&& other) = delete;
+  bool operator==(const BitPlaneGraphicsFactory& other) const = delete;
+  bool operator!=(const BitPlaneGraphicsFactory& other) const = delete;
+
+  virtual std::unique_ptr<IGraphics> GetIGraphics();
+};
+
+}  // namespace ledmatrix
@@ -0,0 +1,40 @@
+/**
+ * @file BitPlaneModulator.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Show a grayscale matrix on single color hardware
+ * @version 0.1
+ * @date 2019-06-18
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+
+#include "src/BitPlaneModulator.h"
+
+namespace ledmatrix {
+
+namespace bit_plane_modulator {
+
+uint8_t GetDuty(uint8_t plane, uint8_t brightness) {
+  // The duty is (level + 1) / 16: halving it for every lower plane keeps the
+  // weights of the planes in powers of two.
+  uint8_t shift = static_cast<uint8_t>(NUMBER_OF_SUB_FRAMES - 1 - plane);
+  uint8_t duty = static_cast<uint8_t>((brightness + 1) >> shift);
+  return ((0 == duty) ? 0 : static_cast<uint8_t>(duty - 1));
+}
+
+void WriteSubFrame(ILedMatrixDriver& hardware,
+                   const IGrayscaleGraphics& graphics, uint8_t subFrame,
+                   uint8_t brightness) {
+  uint8_t plane = subFrame % NUMBER_OF_SUB_FRAMES;
+  hardware.SetBrightness(GetDuty(plane, brightness));
+  hardware.WriteIGraphics(graphics.GetBitPlane(plane));
+}
+
+}  // namespace bit_plane_modulator
+
+}  // namespace ledmatrix
@@ -0,0 +1,81 @@
+/**
+ * @file BitPlaneModulator.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Show a grayscale matrix on single color hardware
+ * @version 0.1
+ * @date 2019-06-18
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "src/IGrayscaleGraphics.h"
+#include "src/ILedMatrixDriver.h"
+
+namespace ledmatrix {
+
+/**
+ * Show the levels of an IGrayscaleGraphics on screens that only have single
+ * color pixels and a global brightness (the PWM duty of the HT1632).
+ *
+ * Every bit plane is a sub-frame shown during the same time, at a PWM duty
+ * proportional to its weight: with the brightest setting, plane 3 is shown at
+ * 16/16, plane 2 at 8/16, plane 1 at 4/16 and plane 0 at 2/16. A display
+ * cycle is then NUMBER_OF_SUB_FRAMES sub-frames only, instead of MAX_LEVEL
+ * with equal duties.
+ *
+ * The sub-frames go through the driver like any other graphics: only the
+ * addresses that differ from the previous sub-frame are sent. The PWM duty of
+ * a plane is set first, then the plane is sent: while it is written, the
+ * screen shows what is left of the previous plane at the new duty, and the
+ * plane keeps its own duty until the end of its sub-frame. The weights only
+ * hold when the write takes a small part of the sub-frame (see
+ * WRITE_TIME_DIVIDER).
+ */
+namespace bit_plane_modulator {
+
+/**
+ * Number of sub-frames of a display cycle.
+ */
+const uint8_t NUMBER_OF_SUB_FRAMES = IGrayscaleGraphics::NUMBER_OF_BIT_PLANES;
+
+/**
+ * Writing a whole frame (see ILedMatrixDriver::GetFrameWriteTimeMicro()) must
+ * take at most 1 / WRITE_TIME_DIVIDER of a sub-frame, so that the weights of
+ * the planes stay within an eighth of their value.
+ */
+const uint8_t WRITE_TIME_DIVIDER = 8;
+
+/**
+ * PWM duty of a bit plane.
+ * @param plane from 0 (least significant bit) to NUMBER_OF_BIT_PLANES - 1.
+ * @param brightness PWM duty of the most significant plane, from 0 to 15.
+ * The lower planes lose their weight at low brightness (they cannot go under
+ * the duty 0).
+ * @return the PWM duty, from 0 to 15.
+ */
+uint8_t GetDuty(uint8_t plane, uint8_t brightness);
+
+/**
+ * Show one sub-frame: set the PWM duty of the plane, then send the plane. The
+ * most significant plane is shown last, at \a brightness: the brightness of
+ * the hardware is the same before and after a whole display cycle.
+ * @param hardware the screens.
+ * @param graphics the levels to show.
+ * @param subFrame from 0 to NUMBER_OF_SUB_FRAMES - 1.
+ * @param brightness PWM duty of the most significant plane, from 0 to 15.
+ */
+void WriteSubFrame(ILedMatrixDriver& hardware,
+                   const IGrayscaleGraphics& graphics, uint8_t subFrame,
+                   uint8_t brightness);
+
+}  // namespace bit_plane_modulator
+
+}  // namespace ledmatrix
@@ -0,0 +1,135 @@
+/**
+ * @file DisplayEffects.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Brightness ramps and blinking done by the hardware
+ * @version 0.1
+ * @date 2019-06-17
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+
+#include "src/DisplayEffects.h"
+
+#include <algorithm>
+
+namespace ledmatrix {
+
+const uint8_t DisplayEffects::MAX_BRIGHTNESS;
+
+namespace {
+
+static const uint32_t MAX_DURATION_MILLI = 0xffffff;
+
+}  // namespace
+
+DisplayEffects::DisplayEffects()
+    : m_epoch(std::chrono::steady_clock::now()),
+      m_ramp(PackRamp(MAX_BRIGHTNESS, MAX_BRIGHTNESS, 0, 0)),
+      m_isBlinking(false),
+      m_sentBrightness(-1),
+      m_isBlinkingSent(false) {}
+
+DisplayEffects::~DisplayEffects() {}
+
+void DisplayEffects::SetBrightness(uint8_t level) {
+  FadeTo(level, 0, std::chrono::steady_clock::now());
+}
+
+void DisplayEffects::FadeTo(uint8_t level, uint32_t durationMilli) {
+  FadeTo(level, durationMilli, std::chrono::steady_clock::now());
+}
+
+void DisplayEffects::FadeTo(uint8_t level, uint32_t durationMilli,
+                            std::chrono::steady_clock::time_point now) {
+  level = std::min(level, MAX_BRIGHTNESS);
+  durationMilli = std::min(durationMilli, MAX_DURATION_MILLI);
+  uint32_t timeMilli = GetTimeMilli(now);
+
+  // The ramp starts where the previous one is now.
+  uint64_t ramp = m_ramp.load();
+  while (!m_ramp.compare_exchange_weak(
+      ramp, PackRamp(GetLevel(ramp, timeMilli), level, durationMilli,
+                     timeMilli))) {
+  }
+}
+
+void DisplayEffects::FadeIn(uint32_t durationMilli) {
+  FadeIn(durationMilli, std::chrono::steady_clock::now());
+}
+
+void DisplayEffects::FadeIn(uint32_t durationMilli,
+                            std::chrono::steady_clock::time_point now) {
+  durationMilli = std::min(durationMilli, MAX_DURATION_MILLI);
+  uint32_t timeMilli = GetTimeMilli(now);
+
+  uint64_t ramp = m_ramp.load();
+  while (!m_ramp.compare_exchange_weak(
+      ramp, PackRamp(0, (ramp >> 4) & 0xf, durationMilli, timeMilli))) {
+  }
+}
+
+void DisplayEffects::Blink(bool on) { m_isBlinking = on; }
+
+uint8_t DisplayEffects::GetBrightness() const {
+  return ((m_ramp.load() >> 4) & 0xf);
+}
+
+uint8_t DisplayEffects::GetAppliedBrightness() const {
+  return ((m_sentBrightness < 0) ? MAX_BRIGHTNESS
+                                 : static_cast<uint8_t>(m_sentBrightness));
+}
+
+void DisplayEffects::Apply(ILedMatrixDriver& hardware) {
+  Apply(hardware, std::chrono::steady_clock::now());
+}
+
+void DisplayEffects::Apply(ILedMatrixDriver& hardware,
+                           std::chrono::steady_clock::time_point now) {
+  uint8_t level = GetLevel(m_ramp.load(), GetTimeMilli(now));
+  if (level != m_sentBrightness) {
+    hardware.SetBrightness(level);
+    m_sentBrightness = level;
+  }
+
+  bool isBlinking = m_isBlinking;
+  if (isBlinking != m_isBlinkingSent) {
+    hardware.Blink(isBlinking);
+    m_isBlinkingSent = isBlinking;
+  }
+}
+
+uint32_t DisplayEffects::GetTimeMilli(
+    std::chrono::steady_clock::time_point now) const {
+  // Wraps after 49 days, the ramps only use differences between times.
+  return (static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(now - m_epoch)
+          .count()));
+}
+
+uint64_t DisplayEffects::PackRamp(uint8_t from, uint8_t to,
+                                  uint32_t durationMilli, uint32_t startMilli) {
+  return ((static_cast<uint64_t>(from) & 0xf) |
+          ((static_cast<uint64_t>(to) & 0xf) << 4) |
+          ((static_cast<uint64_t>(durationMilli) & MAX_DURATION_MILLI) << 8) |
+          (static_cast<uint64_t>(startMilli) << 32));
+}
+
+uint8_t DisplayEffects::GetLevel(uint64_t ramp, uint32_t timeMilli) {
+  int32_t from = ramp & 0xf;
+  int32_t to = (ramp >> 4) & 0xf;
+  uint32_t durationMilli = (ramp >> 8) & MAX_DURATION_MILLI;
+  uint32_t elapsedMilli = timeMilli - static_cast<uint32_t>(ramp >> 32);
+  if (elapsedMilli >= durationMilli) {
+    return (static_cast<uint8_t>(to));
+  }
+  return (static_cast<uint8_t>(
+      from + (to - from) * static_cast<int64_t>(elapsedMilli) /
+                 static_cast<int64_t>(durationMilli)));
+}
+
+}  // namespace ledmatrix
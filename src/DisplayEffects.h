@@ -0,0 +1,143 @@
+/**
+ * @file DisplayEffects.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Brightness ramps and blinking done by the hardware
+ * @version 0.1
+ * @date 2019-06-17
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+
+#include "src/ILedMatrixDriver.h"
+
+namespace ledmatrix {
+
+/**
+ * Effects applied to the whole screen by the HT1632 chips themselves: the
+ * brightness (PWM duty) and the blinking. An effect only costs a command of
+ * 2 bytes per panel when it changes, the frames are not rendered again.
+ *
+ * The effects can be requested from any thread. The display thread calls
+ * Apply() once per cycle, between two frames, to send the commands needed.
+ */
+class DisplayEffects {
+ public:
+  /**
+   * Constructor. The screen is at the maximum brightness and does not blink.
+   */
+  DisplayEffects();
+  virtual ~DisplayEffects();
+
+  // Prevent wrong usage of these operators.
+  DisplayEffects(const DisplayEffects& other) = delete;
+  DisplayEffects& operator=(const DisplayEffects& other) = delete;
+  DisplayEffects(DisplayEffects&& other) = delete;
+  DisplayEffects& operator=(DisplayEffects&& other) = delete;
+  bool operator==(const DisplayEffects& other) const = delete;
+  bool operator!=(const DisplayEffects& other) const = delete;
+
+  /**
+   * Set the brightness right away.
+   * @param level from 0 (least bright) to MAX_BRIGHTNESS (most bright).
+   */
+  void SetBrightness(uint8_t level);
+
+  /**
+   * Go from the current brightness to another one, one PWM level at a time.
+   * @param level from 0 (least bright) to MAX_BRIGHTNESS (most bright).
+   * @param durationMilli duration of the ramp.
+   */
+  void FadeTo(uint8_t level, uint32_t durationMilli);
+
+  /**
+   * Go from the least bright level to the brightness set by SetBrightness()
+   * or FadeTo().
+   * @param durationMilli duration of the ramp.
+   */
+  void FadeIn(uint32_t durationMilli);
+
+  /**
+   * Toggle the pixels blinking
+   * @param on if true, the pixels blink.
+   */
+  void Blink(bool on);
+
+  /**
+   * @return the brightness the screen has, or will have at the end of the
+   * current ramp.
+   */
+  uint8_t GetBrightness() const;
+
+  /**
+   * Display thread.
+   * @return the brightness sent by the last call to Apply().
+   */
+  uint8_t GetAppliedBrightness() const;
+
+  /**
+   * Display thread. Send the commands bringing the hardware to the current
+   * state of the effects.
+   * @param hardware the screens.
+   */
+  void Apply(ILedMatrixDriver& hardware);
+
+  /**
+   * Same as Apply(ILedMatrixDriver&), at a given time.
+   */
+  void Apply(ILedMatrixDriver& hardware,
+             std::chrono::steady_clock::time_point now);
+
+  /**
+   * Same as FadeTo(), starting at a given time.
+   */
+  void FadeTo(uint8_t level, uint32_t durationMilli,
+              std::chrono::steady_clock::time_point now);
+
+  /**
+   * Same as FadeIn(), starting at a given time.
+   */
+  void FadeIn(uint32_t durationMilli,
+              std::chrono::steady_clock::time_point now);
+
+  static const uint8_t MAX_BRIGHTNESS = 15;
+
+ private:
+  /**
+   * Origin of the times stored in the ramp.
+   */
+  std::chrono::steady_clock::time_point m_epoch;
+
+  /**
+   * The current brightness ramp, packed so that it is always read and
+   * written at once: the start level (bits 0 to 3), the end level (bits 4 to
+   * 7), the duration in milliseconds (bits 8 to 31) and the start time in
+   * milliseconds since m_epoch (bits 32 to 63).
+   */
+  std::atomic<uint64_t> m_ramp;
+  std::atomic<bool> m_isBlinking;
+
+  /**
+   * State of the hardware, only used by the display thread. -1 when the
+   * brightness has not been sent yet.
+   */
+  int16_t m_sentBrightness;
+  bool m_isBlinkingSent;
+
+  uint32_t GetTimeMilli(std::chrono::steady_clock::time_point now) const;
+  static uint64_t PackRamp(uint8_t from, uint8_t to, uint32_t durationMilli,
+                           uint32_t startMilli);
+  static uint8_t GetLevel(uint64_t ramp, uint32_t timeMilli);
+};
+
+}  // namespace ledmatrix
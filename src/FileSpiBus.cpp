@@ -0,0 +1,70 @@
+/**
+ * @file FileSpiBus.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief SPI transport writing the messages in a file
+ * @version 0.1
+ * @date 2019-06-15
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+
+#include "src/FileSpiBus.h"
+
+#include <stdio.h>
+
+#include <limits>
+
+#include "spdlog/spdlog.h"
+
+namespace ledmatrix {
+
+FileSpiBus::FileSpiBus(const std::string& path)
+    : m_file(path.c_str(), std::ios::out | std::ios::trunc),
+      m_start(std::chrono::steady_clock::now()),
+      m_numberOfBatches(0) {
+  if (!m_file) {
+    spdlog::error("Failed to open {} to write the SPI messages.", path);
+  }
+}
+
+FileSpiBus::~FileSpiBus() {}
+
+bool FileSpiBus::Setup(int channel) {
+  (void)channel;
+  return (static_cast<bool>(m_file));
+}
+
+int FileSpiBus::GetNumberOfChannels() const {
+  // Any channel is written in the file.
+  return (std::numeric_limits<int>::max());
+}
+
+uint32_t FileSpiBus::GetSpeedHz() const {
+  // The messages are written in the file as soon as they are sent.
+  return (0);
+}
+
+bool FileSpiBus::WriteBatch(const SpiTransfer* transfers, uint16_t count) {
+  long long time = std::chrono::duration_cast<std::chrono::microseconds>(
+                       std::chrono::steady_clock::now() - m_start)
+                       .count();
+  for (uint16_t i = 0; i < count; ++i) {
+    m_file << time << " " << m_numberOfBatches << " " << transfers[i].channel;
+    char byte[4];
+    for (uint16_t n = 0; n < transfers[i].size; ++n) {
+      snprintf(byte, sizeof(byte), " %02x", transfers[i].data[n]);
+      m_file << byte;
+    }
+    m_file << "\n";
+  }
+  ++m_numberOfBatches;
+  m_file.flush();
+  return (static_cast<bool>(m_file));
+}
+
+}  // namespace ledmatrix
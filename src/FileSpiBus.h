@@ -0,0 +1,64 @@
+/**
+ * @file FileSpiBus.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief SPI transport writing the messages in a file
+ * @version 0.1
+ * @date 2019-06-15
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <chrono>
+#include <fstream>
+#include <string>
+
+#include "src/ISpiBus.h"
+
+namespace ledmatrix {
+
+/**
+ * Bus writing every message in a text file, one line per message:
+ * the time in microseconds since the creation of the bus, the number of the
+ * batch, the channel and the bytes in hexadecimal. e.g.
+ * <pre>
+ * 1520 3 0 a0 00 20 ...
+ * </pre>
+ */
+class FileSpiBus : public ISpiBus {
+ public:
+  /**
+   * Constructor.
+   * @param path file to write in. It is overwritten.
+   */
+  explicit FileSpiBus(const std::string& path);
+  virtual ~FileSpiBus();
+
+  // Prevent wrong usage of these operators.
+  FileSpiBus() = delete;
+  FileSpiBus(const FileSpiBus& other) = delete;
+  FileSpiBus& operator=(const FileSpiBus& other) = delete;
+  FileSpiBus(FileSpiBus&& other) = delete;
+  FileSpiBus& operator=(FileSpiBus&& other) = delete;
+  bool operator==(const FileSpiBus& other) const = delete;
+  bool operator!=(const FileSpiBus& other) const = delete;
+
+  virtual bool Setup(int channel);
+  virtual int GetNumberOfChannels() const;
+  virtual uint32_t GetSpeedHz() const;
+  virtual bool WriteBatch(const SpiTransfer* transfers, uint16_t count);
+
+ private:
+  std::ofstream m_file;
+  std::chrono::steady_clock::time_point m_start;
+  uint32_t m_numberOfBatches;
+};
+
+}  // namespace ledmatrix
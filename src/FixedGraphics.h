@@ -0,0 +1,285 @@
+/**
+ * @file FixedGraphics.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Single color Led Matrix with dimensions fixed at compile time
+ * @version 0.1
+ * @date 2019-06-06
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
+#include "spdlog/spdlog.h"
+#include "src/AbstractGraphics.h"
+
+namespace ledmatrix {
+
+/**
+ * Represent a single color Led Matrix of exactly \a Width x \a Height pixels,
+ * such as a screen sized frame buffer for providers displaying static content.
+ *
+ * Every column is packed in the smallest unsigned integer that holds \a Height
+ * bits (bit y is the pixel at row y) and all the columns live in a std::array:
+ * there is no heap allocation and every loop runs over a constant number of
+ * columns.
+ *
+ * The width never changes. Pixels written on the right of the matrix are
+ * dropped, Clear() behaves like Reset() and shifting left or right brings in
+ * blank columns instead of growing the matrix.
+ */
+template <uint16_t Width, uint16_t Height>
+class FixedGraphics : public AbstractGraphics {
+  static_assert(Width > 0, "FixedGraphics needs at least one column");
+  static_assert((Height > 0) && (Height <= 32),
+                "FixedGraphics supports from 1 to 32 rows");
+
+ public:
+  /**
+   * Type used to store a single column.
+   */
+  typedef typename std::conditional<
+      (Height <= 8), uint8_t,
+      typename std::conditional<(Height <= 16), uint16_t,
+                                uint32_t>::type>::type Column;
+
+  static constexpr uint16_t WIDTH = Width;
+  static constexpr uint16_t HEIGHT = Height;
+
+  FixedGraphics() { m_columns.fill(0); }
+  virtual ~FixedGraphics() {}
+
+  // Prevent wrong usage of these operators.
+  FixedGraphics(const FixedGraphics& other) = delete;
+  FixedGraphics& operator=(const FixedGraphics& other) = delete;
+  FixedGraphics(FixedGraphics&& other) = delete;
+  FixedGraphics& operator=(FixedGraphics&& other) = delete;
+  bool operator==(const FixedGraphics& other) const = delete;
+  bool operator!=(const FixedGraphics& other) const = delete;
+
+  /* Pixel operations */
+  virtual void SetPixel(uint16_t x, uint16_t y, bool on) {
+    if (y >= Height) {
+      /*  We are outside of the bounds. That is ok, we just ignore the call
+              and log a message. */
+      spdlog::error(
+          "Tried to set a pixel outside of the bound (at ({}, {}) with a "
+          "matrix of size {}x{}.",
+          x, y, Width, Height);
+      return;
+    }
+    if (x >= Width) {
+      // Writing on the right of a fixed matrix is expected (for example the
+      // blank column added after a text), the pixel is simply not visible.
+      spdlog::debug("Dropping pixel ({}, {}) outside of a fixed matrix.", x, y);
+      return;
+    }
+    MarkDirty(x, 1);
+    if (on) {
+      m_columns[x] |= static_cast<Column>(0x1u << y);
+    } else {
+      m_columns[x] &= static_cast<Column>(~(0x1u << y));
+    }
+  }
+
+  virtual bool GetPixel(uint16_t x, uint16_t y) const {
+    // Everything outside of the bounds is considered as not set
+    if ((x >= Width) || (y >= Height)) {
+      return (false);
+    }
+    return (0 != (m_columns[x] & (0x1u << y)));
+  }
+
+  /* Column operations */
+  virtual void WriteColumns(uint16_t x, uint16_t y, const uint8_t* columns,
+                            uint16_t count) {
+    if ((0 == count) || (x >= Width) || (y >= Height)) {
+      return;
+    }
+    count = std::min<uint16_t>(count, Width - x);
+    MarkDirty(x, count);
+    Column mask = static_cast<Column>((0xFFu << y) & FULL_COLUMN);
+    for (uint16_t i = 0; i < count; ++i) {
+      Column value = static_cast<Column>((uint32_t(columns[i]) << y) & mask);
+      m_columns[x + i] =
+          static_cast<Column>((m_columns[x + i] & ~mask) | value);
+    }
+  }
+
+  virtual void ReadColumns(uint16_t x, uint16_t y, uint8_t* columns,
+                           uint16_t count) const {
+    uint16_t available = 0;
+    if ((x < Width) && (y < Height)) {
+      available = std::min<uint16_t>(count, Width - x);
+      for (uint16_t i = 0; i < available; ++i) {
+        columns[i] = static_cast<uint8_t>(m_columns[x + i] >> y);
+      }
+    }
+    // Everything outside of the bounds is considered as not set
+    memset(columns + available, 0, count - available);
+  }
+
+  virtual void FillColumns(uint16_t x, uint16_t y, uint16_t count,
+                           uint8_t column) {
+    if ((0 == count) || (x >= Width) || (y >= Height)) {
+      return;
+    }
+    count = std::min<uint16_t>(count, Width - x);
+    MarkDirty(x, count);
+    Column mask = static_cast<Column>((0xFFu << y) & FULL_COLUMN);
+    Column value = static_cast<Column>((uint32_t(column) << y) & mask);
+    for (uint16_t i = 0; i < count; ++i) {
+      m_columns[x + i] =
+          static_cast<Column>((m_columns[x + i] & ~mask) | value);
+    }
+  }
+
+  virtual uint16_t GetColumnsView(uint16_t x, uint16_t count,
+                                  const uint8_t** columns) const {
+    // Only byte columns have the layout expected by the callers.
+    if ((sizeof(Column) != 1) || (x >= Width)) {
+      return (0);
+    }
+    *columns = reinterpret_cast<const uint8_t*>(&m_columns[x]);
+    return (std::min<uint16_t>(count, Width - x));
+  }
+
+  /**
+   * Copy the first Width columns of \a graphics (pixels outside of it are OFF)
+   * and take over its scroll hint.
+   * @param graphics the graphics to copy.
+   */
+  void CopyFrom(const IGraphics& graphics) { CopyFrom(graphics, 0, Width); }
+
+  /**
+   * Copy \a count columns of \a graphics starting at column \a x (pixels
+   * outside of it are OFF) and take over its scroll hint. The other columns
+   * are kept.
+   * @param graphics the graphics to copy.
+   * @param x X position of the first column to copy (starts at 0)
+   * @param count number of columns to copy
+   */
+  void CopyFrom(const IGraphics& graphics, uint16_t x, uint16_t count) {
+    count = (x < Width) ? std::min<uint16_t>(count, Width - x) : 0;
+    uint8_t columns[Width];
+    for (uint16_t y = 0; (y < Height) && (0 != count); y += 8) {
+      graphics.ReadColumns(x, y, columns, count);
+      Column mask = static_cast<Column>((0xFFu << y) & FULL_COLUMN);
+      for (uint16_t i = 0; i < count; ++i) {
+        Column value = static_cast<Column>((uint32_t(columns[i]) << y) & mask);
+        m_columns[x + i] =
+            static_cast<Column>((m_columns[x + i] & ~mask) | value);
+      }
+    }
+    int16_t scrollHint = graphics.GetScrollHint();
+    if (0 != scrollHint) {
+      MarkScrolled(scrollHint);
+    } else {
+      MarkDirty(x, count);
+    }
+  }
+
+  /**
+   * Direct access to the packed columns.
+   * @return the Width columns of the matrix, bit y is the pixel at row y.
+   */
+  const std::array<Column, Width>& GetColumns() const { return (m_columns); }
+
+  /* Full matrix operations */
+  virtual uint16_t GetHeight() const { return (Height); }
+  virtual uint16_t GetWidth() const { return (Width); }
+
+  virtual void SetWidth(uint16_t width) {
+    if (width > Width) {
+      spdlog::error(
+          "Cannot set the width of a fixed matrix of size {}x{} to {}.", Width,
+          Height, width);
+    }
+  }
+
+  virtual void Clear() { Reset(); }
+  virtual void Reset() {
+    MarkAllDirty();
+    m_columns.fill(0);
+  }
+
+  virtual void Rotate(Direction direction, uint16_t numberOfRows) {
+    MarkAllDirty();
+    if ((Right == direction) || (Left == direction)) {
+      numberOfRows %= Width;
+      if (Right == direction) {
+        numberOfRows = (Width - numberOfRows) % Width;
+      }
+      std::rotate(m_columns.begin(), m_columns.begin() + numberOfRows,
+                  m_columns.end());
+    } else if ((Up == direction) || (Down == direction)) {
+      ShiftRows(direction, numberOfRows);
+    }
+  }
+
+  virtual void Shift(Direction direction, uint16_t numberOfRows) {
+    MarkShifted(direction, numberOfRows);
+    if ((Right == direction) || (Left == direction)) {
+      numberOfRows = std::min(numberOfRows, Width);
+      if (Left == direction) {
+        std::copy(m_columns.begin() + numberOfRows, m_columns.end(),
+                  m_columns.begin());
+        std::fill(m_columns.end() - numberOfRows, m_columns.end(), 0);
+      } else {
+        std::copy_backward(m_columns.begin(), m_columns.end() - numberOfRows,
+                           m_columns.end());
+        std::fill(m_columns.begin(), m_columns.begin() + numberOfRows, 0);
+      }
+    } else if ((Up == direction) || (Down == direction)) {
+      ShiftRows(direction, numberOfRows);
+    }
+  }
+
+ private:
+  /**
+   * All the rows of a column set.
+   */
+  static constexpr uint32_t FULL_COLUMN =
+      (Height >= 32) ? 0xFFFFFFFFu : ((0x1u << Height) - 1);
+
+  std::array<Column, Width> m_columns;
+
+  /**
+   * Move every pixel of \a numberOfRows rows up (towards the higher rows) or
+   * down. Rows moved out of the matrix are lost.
+   */
+  void ShiftRows(Direction direction, uint16_t numberOfRows) {
+    if (numberOfRows >= Height) {
+      m_columns.fill(0);
+    } else if (Up == direction) {
+      for (Column& column : m_columns) {
+        column = static_cast<Column>((uint32_t(column) << numberOfRows) &
+                                     FULL_COLUMN);
+      }
+    } else {
+      for (Column& column : m_columns) {
+        column = static_cast<Column>(column >> numberOfRows);
+      }
+    }
+  }
+};
+
+template <uint16_t Width, uint16_t Height>
+constexpr uint16_t FixedGraphics<Width, Height>::WIDTH;
+template <uint16_t Width, uint16_t Height>
+constexpr uint16_t FixedGraphics<Width, Height>::HEIGHT;
+template <uint16_t Width, uint16_t Height>
+constexpr uint32_t FixedGraphics<Width, Height>::FULL_COLUMN;
+
+}  // namespace ledmatrix
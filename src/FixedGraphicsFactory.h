@@ -0,0 +1,49 @@
+/**
+ * @file FixedGraphicsFactory.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Factory for FixedGraphics objects
+ * @version 0.1
+ * @date 2019-06-06
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include "GraphicsFactory.h"
+
+#include <memory>
+
+#include "src/FixedGraphics.h"
+
+namespace ledmatrix {
+
+/**
+ * Create FixedGraphics objects of \a Width x \a Height pixels. As the size is
+ * part of the type, this factory is instantiated directly instead of going
+ * through GraphicsFactory::CreateFactory.
+ */
+template <uint16_t Width, uint16_t Height>
+class FixedGraphicsFactory : public GraphicsFactory {
+ public:
+  FixedGraphicsFactory() {}
+  virtual ~FixedGraphicsFactory() {}
+
+  // Prevent wrong usage of these operators.
+  FixedGraphicsFactory(const FixedGraphicsFactory& other) = delete;
+  FixedGraphicsFactory& operator=(const FixedGraphicsFactory& other) = delete;
+  FixedGraphicsFactory(FixedGraphicsFactory&& other) = delete;
+  FixedGraphicsFactory& operator=(FixedGraphicsFactory&& other) = delete;
+  bool operator==(const FixedGraphicsFactory& other) const = delete;
+  bool operator!=(const FixedGraphicsFactory& other) const = delete;
+
+  virtual std::unique_ptr<IGraphics> GetIGraphics() {
+    return (std::unique_ptr<IGraphics>(new FixedGraphics<Width, Height>()));
+  }
+};
+
+}  // namespace ledmatrix
@@ -17,7 +17,9 @@
 
 #include <utility>
 
+#include "src/BitPlaneGraphicsFactory.h"
 #include "src/MonoColor8RowsGraphicsFactory.h"
+#include "src/MonoColorGraphicsFactory.h"
 
 namespace ledmatrix {
 
@@ -28,6 +30,24 @@ GraphicsFactory::~GraphicsFactory() {}
 std::unique_ptr<GraphicsFactory> GraphicsFactory::CreateFactory(
     GraphicsFactoryType type) {
   switch (type) {
+    case (BitPlaneGraphicsFactoryType): {
+      std::unique_ptr<GraphicsFactory> pGraphicsFactory(
+          new BitPlaneGraphicsFactory());
+      return (std::move(pGraphicsFactory));
+    } break;
+
+    case (MonoColor16RowsGraphicsFactoryType): {
+      std::unique_ptr<GraphicsFactory> pGraphicsFactory(
+          new MonoColorGraphicsFactory<uint16_t>());
+      return (std::move(pGraphicsFactory));
+    } break;
+
+    case (MonoColor32RowsGraphicsFactoryType): {
+      std::unique_ptr<GraphicsFactory> pGraphicsFactory(
+          new MonoColorGraphicsFactory<uint32_t>());
+      return (std::move(pGraphicsFactory));
+    } break;
+
     case (MonoColor8RowsGraphicsFactoryType):
     default:
       std::unique_ptr<GraphicsFactory> pGraphicsFactory(
@@ -28,7 +28,12 @@ class GraphicsFactory {
   /**
    * Type of IGraphics objects
    */
-  enum GraphicsFactoryType { MonoColor8RowsGraphicsFactoryType };
+  enum GraphicsFactoryType {
+    MonoColor8RowsGraphicsFactoryType,
+    BitPlaneGraphicsFactoryType,
+    MonoColor16RowsGraphicsFactoryType,
+    MonoColor32RowsGraphicsFactoryType
+  };
 
   GraphicsFactory();
   virtual ~GraphicsFactory();
@@ -16,6 +16,7 @@
 #include "src/GraphicsToolBox.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "spdlog/spdlog.h"
 
@@ -110,6 +111,10 @@ void graphics_toolbox::WriteOnScreen(IGraphics& graphics, const IFont& font,
                                      uint16_t x, uint16_t y,
                                      std::string message) {
   uint16_t charHeight = font.GetSingleCharacterHeight();
+  // Characters of exactly 8 rows fully inside the matrix are written as packed
+  // columns, one call per character instead of one call per pixel.
+  bool packed = (8 == charHeight) && (y >= 7);
+  std::vector<uint8_t> columns;
   uint16_t writeX = x;
   bool first = true;
   bool isSpecialChar = false;
@@ -135,17 +140,37 @@ void graphics_toolbox::WriteOnScreen(IGraphics& graphics, const IFont& font,
     }
     if (!first) {
       // Write n empty column (n = font.GetLetterSpacing())
-      x = writeX;
-      for (; writeX < x + font.GetLetterSpacing(); ++writeX) {
-        for (int16_t writeY = 0; writeY < font.GetSingleCharacterHeight();
-             writeY++) {
-          graphics.SetPixel(writeX, writeY, false);
+      if (packed) {
+        graphics.FillColumns(writeX, 0, font.GetLetterSpacing(), 0);
+        writeX += font.GetLetterSpacing();
+      } else {
+        x = writeX;
+        for (; writeX < x + font.GetLetterSpacing(); ++writeX) {
+          for (int16_t writeY = 0; writeY < font.GetSingleCharacterHeight();
+               writeY++) {
+            graphics.SetPixel(writeX, writeY, false);
+          }
         }
       }
     } else {
       first = false;
     }
     uint16_t charWidth = font.GetSingleCharacterWidth(c);
+    if (packed) {
+      columns.assign(charWidth, 0);
+      for (uint16_t charX = 0; charX < charWidth; ++charX) {
+        for (uint16_t charY = 0; charY < charHeight; ++charY) {
+          if (font.GetCharacterPixel(c, charX, charY)) {
+            columns[charX] |= (0x1 << charY);
+          }
+        }
+      }
+      if (0 != charWidth) {
+        graphics.WriteColumns(writeX, y - 7, &columns[0], charWidth);
+      }
+      writeX += charWidth;
+      continue;
+    }
     uint16_t charX = 0;
     x = writeX;
     for (; writeX < x + charWidth; ++writeX, ++charX) {
@@ -168,7 +193,7 @@ void graphics_toolbox::WriteOnScreen(IGraphics& graphics,
   if (drawable) {
     auto size = drawable->GetSize();
     int xMax = x + size.first;
-    int yMax = std::min((y + size.second), 8u);
+    int yMax = std::min<int>(y + size.second, graphics.GetHeight());
 
     if ((xMax <= 0) || (yMax <= 0)) {
       return;
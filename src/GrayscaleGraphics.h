@@ -0,0 +1,115 @@
+/**
+ * @file GrayscaleGraphics.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Matrix of fixed size with several levels per pixel
+ * @version 0.1
+ * @date 2019-06-18
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+
+#include "src/FixedGraphics.h"
+#include "src/IGrayscaleGraphics.h"
+
+namespace ledmatrix {
+
+/**
+ * Represent a Led Matrix of exactly \a Width x \a Height pixels with
+ * MAX_LEVEL + 1 levels per pixel.
+ *
+ * Every bit plane is a FixedGraphics: the planes are computed when the
+ * pixels are written, not when they are displayed, and the driver encodes
+ * them like any other single color matrix.
+ */
+template <uint16_t Width, uint16_t Height>
+class GrayscaleGraphics : public IGrayscaleGraphics {
+ public:
+  typedef FixedGraphics<Width, Height> BitPlane;
+
+  GrayscaleGraphics() {}
+  virtual ~GrayscaleGraphics() {}
+
+  // Prevent wrong usage of these operators.
+  GrayscaleGraphics(const GrayscaleGraphics& other) = delete;
+  GrayscaleGraphics& operator=(const GrayscaleGraphics& other) = delete;
+  GrayscaleGraphics(GrayscaleGraphics&& other) = delete;
+  GrayscaleGraphics& operator=(GrayscaleGraphics&& other) = delete;
+  bool operator==(const GrayscaleGraphics& other) const = delete;
+  bool operator!=(const GrayscaleGraphics& other) const = delete;
+
+  virtual uint16_t GetHeight() const { return (Height); }
+  virtual uint16_t GetWidth() const { return (Width); }
+
+  virtual void Clear() {
+    for (BitPlane& plane : m_planes) {
+      plane.Reset();
+    }
+  }
+
+  virtual void SetLevel(uint16_t x, uint16_t y, uint8_t level) {
+    if (level > MAX_LEVEL) {
+      level = MAX_LEVEL;
+    }
+    for (uint8_t p = 0; p < NUMBER_OF_BIT_PLANES; ++p) {
+      m_planes[p].SetPixel(x, y, 0 != (level & (0x1 << p)));
+    }
+  }
+
+  virtual uint8_t GetLevel(uint16_t x, uint16_t y) const {
+    uint8_t level = 0;
+    for (uint8_t p = 0; p < NUMBER_OF_BIT_PLANES; ++p) {
+      if (m_planes[p].GetPixel(x, y)) {
+        level = static_cast<uint8_t>(level | (0x1 << p));
+      }
+    }
+    return (level);
+  }
+
+  virtual void Shift(Direction direction, uint16_t numberOfRows) {
+    for (BitPlane& plane : m_planes) {
+      plane.Shift(direction, numberOfRows);
+    }
+  }
+
+  virtual const IGraphics& GetBitPlane(uint8_t plane) const {
+    return (m_planes[std::min<uint8_t>(plane, NUMBER_OF_BIT_PLANES - 1)]);
+  }
+
+  /**
+   * Copy the first Width columns of every bit plane of \a graphics.
+   * @param graphics the graphics to copy.
+   */
+  void CopyFrom(const IGrayscaleGraphics& graphics) {
+    for (uint8_t p = 0; p < NUMBER_OF_BIT_PLANES; ++p) {
+      m_planes[p].CopyFrom(graphics.GetBitPlane(p));
+    }
+  }
+
+  /**
+   * @return a hash of the levels of all the pixels (see
+   * AbstractGraphics::GetContentHash()).
+   */
+  uint64_t GetContentHash() const {
+    uint64_t hash = 0;
+    for (const BitPlane& plane : m_planes) {
+      hash = (hash * 31) ^ plane.GetContentHash();
+    }
+    return (hash);
+  }
+
+ private:
+  std::array<BitPlane, NUMBER_OF_BIT_PLANES> m_planes;
+};
+
+}  // namespace ledmatrix
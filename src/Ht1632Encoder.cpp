@@ -0,0 +1,337 @@
+/**
+ * @file Ht1632Encoder.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Conversion of packed columns into the HT1632 write command
+ * @version 0.1
+ * @date 2019-06-12
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+
+#include "src/Ht1632Encoder.h"
+
+#include <string.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define HT1632_ENCODER_NEON
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define HT1632_ENCODER_SSE2
+#endif
+
+namespace {
+
+/**
+ * 101 is the write command and 00000 are the first 5 bits of the address.
+ */
+const uint8_t WRITE_COMMAND_HEADER = 0xa0;
+
+/*
+ * Every encoder works in the same way. The bits of every column are reversed,
+ * so that row 0 is the most significant bit. The column x is then split
+ * between the bytes x + 1 (its first 6 rows, after the 2 last bits of the
+ * address or of the previous column) and x + 2 (its last 2 rows).
+ */
+
+/**
+ * Load 8 columns in a 64 bits word, column i in byte i (compiles to a single
+ * load on little endian targets).
+ */
+inline uint64_t Load64(const uint8_t* columns) {
+  uint64_t word = 0;
+  for (int i = 7; i >= 0; --i) {
+    word = (word << 8) | columns[i];
+  }
+  return (word);
+}
+
+/**
+ * Store the 8 bytes of \a word, byte i at data[i].
+ */
+inline void Store64(uint64_t word, uint8_t* data) {
+  for (int i = 0; i < 8; ++i) {
+    data[i] = static_cast<uint8_t>(word);
+    word >>= 8;
+  }
+}
+
+/**
+ * Reverse the order of the bits of every byte of \a word.
+ */
+inline uint64_t ReverseBits64(uint64_t word) {
+  word = ((word >> 4) & 0x0F0F0F0F0F0F0F0Full) |
+         ((word & 0x0F0F0F0F0F0F0F0Full) << 4);
+  word = ((word >> 2) & 0x3333333333333333ull) |
+         ((word & 0x3333333333333333ull) << 2);
+  word = ((word >> 1) & 0x5555555555555555ull) |
+         ((word & 0x5555555555555555ull) << 1);
+  return (word);
+}
+
+/**
+ * Reverse the order of the bits of a byte (bit 0 becomes bit 7).
+ */
+inline uint8_t ReverseBits(uint8_t value) {
+  value = static_cast<uint8_t>(((value & 0xF0) >> 4) | ((value & 0x0F) << 4));
+  value = static_cast<uint8_t>(((value & 0xCC) >> 2) | ((value & 0x33) << 2));
+  value = static_cast<uint8_t>(((value & 0xAA) >> 1) | ((value & 0x55) << 1));
+  return (value);
+}
+
+/**
+ * Encode the byte \a index (from 1 to 32) of the command: last 2 rows of the
+ * column index - 2 (or of the address) and first 6 rows of the column
+ * index - 1.
+ */
+inline uint8_t EncodeByte(const uint8_t* columns, uint16_t index) {
+  uint8_t previous = (index >= 2) ? ReverseBits(columns[index - 2]) : 0;
+  return (static_cast<uint8_t>((previous << 6) |
+                               (ReverseBits(columns[index - 1]) >> 2)));
+}
+
+/**
+ * @return the 4 pixels stored at \a address (row 0 of the column in the most
+ * significant bit).
+ */
+inline uint8_t GetNibble(const uint8_t* columns, uint16_t address) {
+  uint8_t column = ReverseBits(columns[address / 2]);
+  return ((0 == (address & 0x1)) ? (column >> 4) : (column & 0x0F));
+}
+
+/**
+ * @return the size in bytes of a command writing \a numberOfNibbles
+ * addresses (10 bits of header, then 4 bits per address).
+ */
+inline uint16_t GetBurstSize(uint16_t numberOfNibbles) {
+  return ((10 + 4 * numberOfNibbles + 7) / 8);
+}
+
+/**
+ * Fill the header and the last byte of the command (last 2 rows of the last
+ * column followed by the first 6 rows of the first one).
+ * @param first first column, bits reversed.
+ * @param last last column, bits reversed.
+ */
+inline void EncodeEnds(uint8_t first, uint8_t last, uint8_t* data) {
+  data[0] = WRITE_COMMAND_HEADER;
+  data[33] = static_cast<uint8_t>((last << 6) | (first >> 2));
+}
+
+#if defined(HT1632_ENCODER_NEON)
+
+inline uint8x16_t ReverseBits128(uint8x16_t columns) {
+#if defined(__aarch64__)
+  return (vrbitq_u8(columns));
+#else
+  columns = vorrq_u8(vshrq_n_u8(columns, 4), vshlq_n_u8(columns, 4));
+  columns = vorrq_u8(vshrq_n_u8(vandq_u8(columns, vdupq_n_u8(0xCC)), 2),
+                     vshlq_n_u8(vandq_u8(columns, vdupq_n_u8(0x33)), 2));
+  columns = vorrq_u8(vshrq_n_u8(vandq_u8(columns, vdupq_n_u8(0xAA)), 1),
+                     vshlq_n_u8(vandq_u8(columns, vdupq_n_u8(0x55)), 1));
+  return (columns);
+#endif
+}
+
+/**
+ * @param previous lane i is the column before the one of lane i in current.
+ */
+inline uint8x16_t Interleave128(uint8x16_t previous, uint8x16_t current) {
+  return (vorrq_u8(vshlq_n_u8(previous, 6), vshrq_n_u8(current, 2)));
+}
+
+#elif defined(HT1632_ENCODER_SSE2)
+
+inline __m128i ReverseBits128(__m128i columns) {
+  // There is no 8 bits shift, the bits moved to the neighbour byte by the 16
+  // bits shifts are masked.
+  const __m128i mask4 = _mm_set1_epi8(0x0F);
+  const __m128i mask2 = _mm_set1_epi8(0x33);
+  const __m128i mask1 = _mm_set1_epi8(0x55);
+  columns = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(columns, 4), mask4),
+                         _mm_slli_epi16(_mm_and_si128(columns, mask4), 4));
+  columns = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(columns, 2), mask2),
+                         _mm_slli_epi16(_mm_and_si128(columns, mask2), 2));
+  columns = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(columns, 1), mask1),
+                         _mm_slli_epi16(_mm_and_si128(columns, mask1), 1));
+  return (columns);
+}
+
+/**
+ * @param previous byte i is the column before the one of byte i in current.
+ */
+inline __m128i Interleave128(__m128i previous, __m128i current) {
+  const __m128i highMask = _mm_set1_epi8(static_cast<char>(0xC0));
+  const __m128i lowMask = _mm_set1_epi8(0x3F);
+  return (_mm_or_si128(_mm_and_si128(_mm_slli_epi16(previous, 6), highMask),
+                       _mm_and_si128(_mm_srli_epi16(current, 2), lowMask)));
+}
+
+#endif
+
+}  // namespace
+
+namespace ledmatrix {
+
+namespace ht1632_encoder {
+
+void EncodePortable(const uint8_t* columns, uint8_t* data) {
+  uint8_t first = 0;
+  uint64_t previous = 0;
+  for (uint16_t x = 0; x < NUMBER_OF_COLUMNS; x += 8) {
+    uint64_t current = ReverseBits64(Load64(columns + x));
+    if (0 == x) {
+      first = static_cast<uint8_t>(current);
+    }
+    // Byte i is the column before the one of byte i in current (the last 2
+    // bits of the address for the first column).
+    uint64_t shifted = (current << 8) | (previous >> 56);
+    Store64(((shifted << 6) & 0xC0C0C0C0C0C0C0C0ull) |
+                ((current >> 2) & 0x3F3F3F3F3F3F3F3Full),
+            data + x + 1);
+    previous = current;
+  }
+  EncodeEnds(first, static_cast<uint8_t>(previous >> 56), data);
+}
+
+#if defined(HT1632_ENCODER_NEON)
+
+void Encode(const uint8_t* columns, uint8_t* data) {
+  uint8x16_t low = ReverseBits128(vld1q_u8(columns));
+  uint8x16_t high = ReverseBits128(vld1q_u8(columns + 16));
+  vst1q_u8(data + 1, Interleave128(vextq_u8(vdupq_n_u8(0), low, 15), low));
+  vst1q_u8(data + 17, Interleave128(vextq_u8(low, high, 15), high));
+  EncodeEnds(vgetq_lane_u8(low, 0), vgetq_lane_u8(high, 15), data);
+}
+
+#elif defined(HT1632_ENCODER_SSE2)
+
+void Encode(const uint8_t* columns, uint8_t* data) {
+  __m128i low = ReverseBits128(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns)));
+  __m128i high = ReverseBits128(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns + 16)));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(data + 1),
+                   Interleave128(_mm_slli_si128(low, 1), low));
+  _mm_storeu_si128(
+      reinterpret_cast<__m128i*>(data + 17),
+      Interleave128(
+          _mm_or_si128(_mm_slli_si128(high, 1), _mm_srli_si128(low, 15)),
+          high));
+  EncodeEnds(static_cast<uint8_t>(_mm_cvtsi128_si32(low)),
+             static_cast<uint8_t>(_mm_cvtsi128_si32(_mm_srli_si128(high, 15))),
+             data);
+}
+
+#else
+
+void Encode(const uint8_t* columns, uint8_t* data) {
+  EncodePortable(columns, data);
+}
+
+#endif
+
+void EncodeScrolled(const uint8_t* columns, int16_t scroll, uint8_t* data) {
+  if ((0 == scroll) || (scroll <= -int16_t(NUMBER_OF_COLUMNS)) ||
+      (scroll >= int16_t(NUMBER_OF_COLUMNS))) {
+    Encode(columns, data);
+    return;
+  }
+
+  // The bytes from 2 to 32 only depend on two consecutive columns, they move
+  // with them. Byte 1 (the address) and byte 33 (the first column again) are
+  // always encoded.
+  uint16_t first = 1;
+  uint16_t end = 2;
+  if (scroll > 0) {
+    memmove(data + 2, data + 2 + scroll, 31 - scroll);
+    data[1] = EncodeByte(columns, 1);
+    first = 33 - scroll;
+    end = 33;
+  } else {
+    memmove(data + 2 - scroll, data + 2, 31 + scroll);
+    end = 2 - scroll;
+  }
+  for (uint16_t index = first; index < end; ++index) {
+    data[index] = EncodeByte(columns, index);
+  }
+  EncodeEnds(ReverseBits(columns[0]),
+             ReverseBits(columns[NUMBER_OF_COLUMNS - 1]), data);
+}
+
+uint16_t EncodeBurst(const uint8_t* columns, const Burst& burst,
+                     uint8_t* data) {
+  uint16_t size = 0;
+  uint32_t bits = (WRITE_COMMAND_HEADER >> 5);
+  uint16_t numberOfBits = 3;
+  uint16_t address = burst.firstAddress % NUMBER_OF_ADDRESSES;
+  bits = (bits << 7) | address;
+  numberOfBits += 7;
+
+  // Every address after the wanted ones is a padding nibble, only sent until
+  // the end of the last byte.
+  for (uint16_t i = 0; (i < burst.numberOfNibbles) || (0 != numberOfBits);
+       ++i) {
+    uint16_t padding = (i < burst.numberOfNibbles) ? 0 : 8 - numberOfBits;
+    uint8_t nibble = GetNibble(columns, address);
+    if ((0 != padding) && (padding < 4)) {
+      bits = (bits << padding) | (nibble >> (4 - padding));
+      numberOfBits += padding;
+    } else {
+      bits = (bits << 4) | nibble;
+      numberOfBits += 4;
+    }
+    while (numberOfBits >= 8) {
+      numberOfBits -= 8;
+      data[size++] = static_cast<uint8_t>(bits >> numberOfBits);
+    }
+    address = (address + 1) % NUMBER_OF_ADDRESSES;
+  }
+  return (size);
+}
+
+uint16_t PlanBursts(const uint8_t* previousColumns, const uint8_t* columns,
+                    Burst* bursts) {
+  uint16_t numberOfBursts = 0;
+  uint32_t cost = 0;
+  for (uint16_t address = 0; address < NUMBER_OF_ADDRESSES; ++address) {
+    if (GetNibble(previousColumns, address) == GetNibble(columns, address)) {
+      continue;
+    }
+    if (0 != numberOfBursts) {
+      // Extend the last burst up to this address, or start a new one,
+      // whichever is cheaper.
+      Burst& last = bursts[numberOfBursts - 1];
+      uint16_t extended = address + 1 - last.firstAddress;
+      uint16_t extendedCost = GetBurstSize(extended);
+      uint16_t separateCost = GetBurstSize(last.numberOfNibbles) +
+                              GetBurstSize(1) + BURST_OVERHEAD;
+      if (extendedCost <= separateCost) {
+        cost += extendedCost - GetBurstSize(last.numberOfNibbles);
+        last.numberOfNibbles = extended;
+        continue;
+      }
+    }
+    bursts[numberOfBursts].firstAddress = address;
+    bursts[numberOfBursts].numberOfNibbles = 1;
+    ++numberOfBursts;
+    cost += GetBurstSize(1) + BURST_OVERHEAD;
+  }
+
+  if ((numberOfBursts > 1) &&
+      (cost >= static_cast<uint32_t>(FRAME_SIZE + BURST_OVERHEAD))) {
+    bursts[0].firstAddress = 0;
+    bursts[0].numberOfNibbles = NUMBER_OF_ADDRESSES;
+    numberOfBursts = 1;
+  }
+  return (numberOfBursts);
+}
+
+}  // namespace ht1632_encoder
+
+}  // namespace ledmatrix
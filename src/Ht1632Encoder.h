@@ -0,0 +1,121 @@
+/**
+ * @file Ht1632Encoder.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Conversion of packed columns into the HT1632 write command
+ * @version 0.1
+ * @date 2019-06-12
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+namespace ledmatrix {
+
+namespace ht1632_encoder {
+
+/**
+ * Number of columns of a single HT1632 matrix.
+ */
+const uint16_t NUMBER_OF_COLUMNS = 32;
+
+/**
+ * Size in bytes of the write command filling a whole matrix.
+ */
+const uint16_t FRAME_SIZE = 34;
+
+/**
+ * Number of addresses of a matrix. Every address holds 4 pixels (a nibble):
+ * rows 0 to 3 of column x at address 2x, rows 4 to 7 at address 2x + 1.
+ */
+const uint16_t NUMBER_OF_ADDRESSES = 64;
+
+/**
+ * Estimated cost of a write command on top of its bytes (chip select and
+ * transfer setup), in bytes worth of SPI clocks.
+ */
+const uint16_t BURST_OVERHEAD = 4;
+
+/**
+ * Maximum number of write commands needed to update a matrix.
+ */
+const uint16_t MAX_NUMBER_OF_BURSTS = NUMBER_OF_ADDRESSES / 2;
+
+/**
+ * A write command covering \a numberOfNibbles addresses from \a firstAddress.
+ */
+struct Burst {
+  uint16_t firstAddress;
+  uint16_t numberOfNibbles;
+};
+
+/**
+ * Build the command writing 32 columns of 8 rows at address 0.
+ *
+ * The command starts with 10 bits of header (101 followed by the 7 bits of
+ * the address), then the 256 pixels, row 0 of every column first. As the SPI
+ * driver only sends whole bytes, the 6 remaining bits of the last byte are the
+ * first 6 pixels again (written twice at the same address).
+ *
+ * Uses NEON on ARM, SSE2 on x86 and EncodePortable() otherwise.
+ * @param columns the 32 columns to write (bit y is the pixel at row y).
+ * @param data receives the FRAME_SIZE bytes of the command.
+ */
+void Encode(const uint8_t* columns, uint8_t* data);
+
+/**
+ * Same as Encode(), using only 64 bits integer operations.
+ * @param columns the 32 columns to write (bit y is the pixel at row y).
+ * @param data receives the FRAME_SIZE bytes of the command.
+ */
+void EncodePortable(const uint8_t* columns, uint8_t* data);
+
+/**
+ * Update the command \a data written for the previous content of the matrix,
+ * after this content scrolled by \a scroll columns. The bytes made of columns
+ * that were already on the matrix are moved, only the ones holding new
+ * columns are encoded.
+ * @param columns the 32 columns to write. Column x must be the column
+ * x + \a scroll of the previous content, when it exists.
+ * @param scroll number of columns the content moved to the left (negative
+ * when it moved to the right). Out of ]-32, 32[, everything is encoded.
+ * @param data the FRAME_SIZE bytes of the previous command, updated.
+ */
+void EncodeScrolled(const uint8_t* columns, int16_t scroll, uint8_t* data);
+
+/**
+ * Build the command writing \a numberOfNibbles addresses from \a firstAddress.
+ * The last byte is completed with the pixels of the next addresses (written
+ * again with the same value). Writing the 64 addresses from 0 gives the same
+ * command as Encode().
+ * @param columns the 32 columns of the matrix (bit y is the pixel at row y).
+ * @param burst the addresses to write.
+ * @param data receives the command (at most FRAME_SIZE bytes).
+ * @return the size of the command in bytes.
+ */
+uint16_t EncodeBurst(const uint8_t* columns, const Burst& burst,
+                     uint8_t* data);
+
+/**
+ * Choose the write commands updating a matrix from \a previousColumns to
+ * \a columns with the fewest SPI clocks: only the modified addresses are
+ * written, neighbouring ones being merged when it is cheaper than another
+ * command. When it is not cheaper than writing everything, a single burst
+ * covers the whole matrix.
+ * @param previousColumns the 32 columns currently shown by the matrix.
+ * @param columns the 32 columns to show.
+ * @param bursts receives up to MAX_NUMBER_OF_BURSTS write commands.
+ * @return the number of write commands (0 if nothing changed).
+ */
+uint16_t PlanBursts(const uint8_t* previousColumns, const uint8_t* columns,
+                    Burst* bursts);
+
+}  // namespace ht1632_encoder
+
+}  // namespace ledmatrix
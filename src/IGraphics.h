@@ -27,6 +27,27 @@ enum Direction {
   Down       //!< Down
 };
 
+/**
+ * A range of columns, from \a first (included) to \a end (excluded).
+ */
+struct ColumnRange {
+  uint16_t first;
+  uint16_t end;
+
+  /**
+   * @return true if the range does not contain any column.
+   */
+  bool IsEmpty() const { return (first >= end); }
+
+  /**
+   * @return true if the range contains at least one of the \a count columns
+   * starting at \a x.
+   */
+  bool Intersects(uint16_t x, uint16_t count) const {
+    return ((first < end) && (first < x + count) && (x < end));
+  }
+};
+
 /**
  * \a IGraphics is an interface to a model representation of some Led Matrix
  * hardware. The goal is to define generic functions that allows more elaborate
@@ -83,6 +104,139 @@ class IGraphics {
    */
   virtual bool GetPixel(uint16_t x, uint16_t y) const = 0;
 
+  /**
+   * Write \a count packed columns, starting at column \a x. Bit n of each
+   * column is the pixel at row \a y + n. Rows outside of the y boundaries are
+   * ignored. If the columns are outside the x boundaries, the size of the
+   * matrix will be increased accordingly.
+   * The default implementation relies on SetPixel. Implementations storing
+   * packed columns should override it.
+   * @param x X position of the first column (starts at 0)
+   * @param y Y position of the row stored in bit 0 of each column
+   * @param columns packed columns to write
+   * @param count number of columns to write
+   */
+  virtual void WriteColumns(uint16_t x, uint16_t y, const uint8_t* columns,
+                            uint16_t count) {
+    uint16_t height = GetHeight();
+    for (uint16_t i = 0; i < count; ++i) {
+      for (uint16_t n = 0; (n < 8) && (y + n < height); ++n) {
+        SetPixel(x + i, y + n, 0 != (columns[i] & (0x1 << n)));
+      }
+    }
+  }
+
+  /**
+   * Read \a count packed columns, starting at column \a x. Bit n of each
+   * column is the pixel at row \a y + n. Pixels outside of the boundaries are
+   * read as OFF.
+   * The default implementation relies on GetPixel. Implementations storing
+   * packed columns should override it.
+   * @param x X position of the first column (starts at 0)
+   * @param y Y position of the row stored in bit 0 of each column
+   * @param columns buffer receiving the packed columns
+   * @param count number of columns to read
+   */
+  virtual void ReadColumns(uint16_t x, uint16_t y, uint8_t* columns,
+                           uint16_t count) const {
+    for (uint16_t i = 0; i < count; ++i) {
+      uint8_t column = 0;
+      for (uint16_t n = 0; n < 8; ++n) {
+        if (GetPixel(x + i, y + n)) {
+          column |= (0x1 << n);
+        }
+      }
+      columns[i] = column;
+    }
+  }
+
+  /**
+   * Give a read-only access to the packed columns stored from column \a x,
+   * without copying them. Bit y of each column is the pixel at row y.
+   * Only a part of the wanted range may be returned (for example when the
+   * storage is not contiguous), the remaining columns can be requested by
+   * another call. The view is valid until the next non-const call.
+   * The default implementation returns no view: ReadColumns has to be used.
+   * @param x X position of the first column (starts at 0)
+   * @param count number of wanted columns
+   * @param columns receives a pointer to the first column
+   * @return number of columns that can be read from \a columns (0 if none)
+   */
+  virtual uint16_t GetColumnsView(uint16_t x, uint16_t count,
+                                  const uint8_t** columns) const {
+    (void)x;
+    (void)count;
+    (void)columns;
+    return (0);
+  }
+
+  /**
+   * Write the same packed column \a count times, starting at column \a x.
+   * Filling with 0 clears a range of columns.
+   * @param x X position of the first column (starts at 0)
+   * @param y Y position of the row stored in bit 0 of \a column
+   * @param count number of columns to write
+   * @param column packed column to write
+   */
+  virtual void FillColumns(uint16_t x, uint16_t y, uint16_t count,
+                           uint8_t column) {
+    uint16_t height = GetHeight();
+    for (uint16_t i = 0; i < count; ++i) {
+      for (uint16_t n = 0; (n < 8) && (y + n < height); ++n) {
+        SetPixel(x + i, y + n, 0 != (column & (0x1 << n)));
+      }
+    }
+  }
+
+  /**
+   * Return the range of screen columns that may have changed since the last
+   * call to ClearDirtyColumns(). Consumers use it to skip the parts of the
+   * screen that are already up to date.
+   * The default implementation does not track anything and reports every
+   * column as dirty.
+   * @return the dirty columns (empty if nothing changed)
+   */
+  virtual ColumnRange GetDirtyColumns() const {
+    ColumnRange range = {0, UINT16_MAX};
+    return (range);
+  }
+
+  /**
+   * Mark every column as up to date, and make the current content the
+   * reference of the scroll hint. Called by the consumer once the content has
+   * been read.
+   */
+  virtual void ClearDirtyColumns() {}
+
+  /**
+   * Tell whether the screen only scrolled since the last call to
+   * ClearDirtyColumns(): column x then shows what column x + hint showed
+   * (the columns coming in on the side are new). This is only a hint, that
+   * consumers should check before relying on it.
+   * The default implementation does not track anything and returns 0.
+   * @return the number of columns the content moved to the left (negative
+   * when it moved to the right), 0 if unknown or if it did not only scroll.
+   */
+  virtual int16_t GetScrollHint() const { return (0); }
+
+  /**
+   * Return a counter incremented by every operation that may modify the
+   * content of the matrix. Two equal generations of the same object mean that
+   * nothing changed in between.
+   * The default implementation does not track anything and returns 0: the
+   * content must then always be considered as modified.
+   * @return the current generation, 0 if not tracked.
+   */
+  virtual uint32_t GetGeneration() const { return (0); }
+
+  /**
+   * Return a hash of the content of the matrix, so that a content drawn again
+   * identically (e.g. reset and redrawn) can be detected. Only meaningful when
+   * GetGeneration() is not 0.
+   * @return the hash of all the pixels of the matrix.
+   */
+  virtual uint64_t GetContentHash() const { return (0); }
+
   /**
    * Rotate the matrix in the wanted direction.
    * @param direction left or right.
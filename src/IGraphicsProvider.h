@@ -21,6 +21,7 @@
 #include <cstdint>
 
 #include "src/IGraphics.h"
+#include "src/IGrayscaleGraphics.h"
 
 namespace ledmatrix {
 /**
@@ -35,6 +36,11 @@ class IGraphicsProvider {
  public:
   virtual ~IGraphicsProvider() {}
 
+  /**
+   * Period of the compute cycles of a provider that does not say otherwise.
+   */
+  static const uint32_t DEFAULT_COMPUTE_CYCLE_TIME_MILLI = 1000;
+
   /**
    * The runtime will call this method inbetween two display cycles. The goal is
    * to have long operations executed here.
@@ -55,6 +61,39 @@ class IGraphicsProvider {
    */
   virtual IGraphics* GetIGraphics() const = 0;
 
+  /**
+   * Return the current grayscale graphics of the provider, if it has one. It
+   * is then shown instead of GetIGraphics().
+   * @return IGrayscaleGraphics* A pointer to the current IGrayscaleGraphics
+   * object, NULL for the single color providers.
+   */
+  virtual IGrayscaleGraphics* GetIGrayscaleGraphics() const { return (NULL); }
+
+  /**
+   * Time between two calls to ExecuteComputeCycle(). Every provider has its
+   * own timer, the runtime does not wake up for the others.
+   * @return uint32_t The period in milliseconds, at least 1.
+   */
+  virtual uint32_t GetComputeCycleTimeMilli() const {
+    return (DEFAULT_COMPUTE_CYCLE_TIME_MILLI);
+  }
+
+  /**
+   * The runtime gives here the function to call when the provider may need
+   * to be scheduled differently (IsActive(), GetPriority() or
+   * CanBePreampted() may have changed). The runtime then chooses the provider
+   * to display right away instead of at its next compute cycle. Providers
+   * that never call it are simply polled.
+   * It is called once, before the provider is shared with any other thread
+   * (the runtime does it in AddGraphicsProvider()), so the provider can read
+   * the callback from any thread without a lock.
+   * @param callback The function to call, from any thread. It only sets a
+   * flag and wakes the runtime up, it never blocks.
+   */
+  virtual void SetStateChangedCallback(const std::function<void()>& callback) {
+    (void)callback;
+  }
+
   /**
    * Indication of whether there is something to be displayed or not.
    * 
@@ -89,30 +128,4 @@ class IGraphicsProvider {
   virtual std::string GetName() const = 0;
 };
 
-/**
- * Comparator for IGraphics provider. Useful to determine which provider should
- * be selected from a list.
- */
-struct IGraphicsProviderPriorityCompare
-    : public std::binary_function<std::unique_ptr<IGraphicsProvider>,
-                                  std::unique_ptr<IGraphicsProvider>, bool> {
-  /**
-   * @brief Compare two providers to determine which one should be selected first
-   * 
-   * @param left the first provider to test.
-   * @param right the second provider to test.
-   * @return true if left should be chosen.
-   * @return false if right should be chosen.
-   */
-  bool operator()(const std::unique_ptr<IGraphicsProvider>& left,
-                  const std::unique_ptr<IGraphicsProvider>& right) const {
-    if ((left->IsActive()) && (!(right->IsActive()))) {
-      return (true);
-    } else if ((!left->IsActive()) && ((right->IsActive()))) {
-      return (false);
-    } else {
-      return (left->GetPriority() > right->GetPriority());
-    }
-  }
-};
 }  // namespace ledmatrix
@@ -0,0 +1,93 @@
+/**
+ * @file IGrayscaleGraphics.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Interface for the matrices with several levels per pixel
+ * @version 0.1
+ * @date 2019-06-18
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "src/IGraphics.h"
+
+namespace ledmatrix {
+
+/**
+ * A Led Matrix where every pixel has a level, from 0 (OFF) to MAX_LEVEL.
+ *
+ * The levels are stored as NUMBER_OF_BIT_PLANES single color matrices: the
+ * pixel (x, y) of bit plane p is ON when bit p of the level is set. The bit
+ * planes are what the hardware shows, one after the other (see
+ * bit_plane_modulator).
+ */
+class IGrayscaleGraphics {
+ public:
+  virtual ~IGrayscaleGraphics() {}
+
+  /**
+   * Number of bits of a level.
+   */
+  static const uint8_t NUMBER_OF_BIT_PLANES = 4;
+
+  /**
+   * Brightest level.
+   */
+  static const uint8_t MAX_LEVEL = (0x1 << NUMBER_OF_BIT_PLANES) - 1;
+
+  /**
+   * Get the height of the matrix.
+   * @return uint16_t The height in pixels.
+   */
+  virtual uint16_t GetHeight() const = 0;
+
+  /**
+   * Get the width of the matrix.
+   * @return uint16_t The width in pixels.
+   */
+  virtual uint16_t GetWidth() const = 0;
+
+  /**
+   * Set every pixel to 0.
+   */
+  virtual void Clear() = 0;
+
+  /**
+   * Set the level of a pixel.
+   * @param x column of the pixel.
+   * @param y row of the pixel.
+   * @param level from 0 to MAX_LEVEL, higher levels are clamped.
+   */
+  virtual void SetLevel(uint16_t x, uint16_t y, uint8_t level) = 0;
+
+  /**
+   * Get the level of a pixel.
+   * @param x column of the pixel.
+   * @param y row of the pixel.
+   * @return the level of the pixel, 0 outside of the matrix.
+   */
+  virtual uint8_t GetLevel(uint16_t x, uint16_t y) const = 0;
+
+  /**
+   * Shift every bit plane.
+   * @param direction direction of the shift.
+   * @param numberOfRows number of rows or columns to shift.
+   */
+  virtual void Shift(Direction direction, uint16_t numberOfRows) = 0;
+
+  /**
+   * Get one of the bit planes.
+   * @param plane from 0 (least significant bit) to NUMBER_OF_BIT_PLANES - 1.
+   * @return the single color matrix of the bit plane.
+   */
+  virtual const IGraphics& GetBitPlane(uint8_t plane) const = 0;
+};
+
+}  // namespace ledmatrix
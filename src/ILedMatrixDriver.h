@@ -0,0 +1,80 @@
+/**
+ * @file ILedMatrixDriver.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Interface for the drivers of the led matrices
+ * @version 0.1
+ * @date 2019-06-15
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "src/IGraphics.h"
+
+namespace ledmatrix {
+
+/**
+ * \a ILedMatrixDriver prints IGraphics objects on the physical screen(s).
+ */
+class ILedMatrixDriver {
+ public:
+  virtual ~ILedMatrixDriver() {}
+
+  /**
+   * Clear the screen
+   */
+  virtual void Clear() = 0;
+
+  /**
+   * Print the content of graphics on the screen. Will start at position (0,0).
+   * Everything outside of the screen is ignored.
+   * @param graphics contains what will be printed.
+   */
+  virtual void WriteIGraphics(const IGraphics& graphics) = 0;
+
+  /**
+   * Tell whether the screen does not show the last graphics written, because
+   * it was dropped on its way (e.g. by a busy bus). The caller then writes it
+   * again, even when it did not change.
+   * @return true if the last graphics written must be written again.
+   */
+  virtual bool IsFrameDropped() const = 0;
+
+  /**
+   * Set the brightness of the screen
+   * @param level level of brightness. Range from 0 (least bright) to 16 (most
+   * bright).
+   */
+  virtual void SetBrightness(unsigned char level) = 0;
+
+  /**
+   * Toggle the pixels blinking
+   * @param on if true, the pixels blink.
+   */
+  virtual void Blink(bool on) = 0;
+
+  /**
+   * Return the actual width of the physical screen
+   */
+  virtual uint16_t GetWidth() const = 0;
+
+  /**
+   * Return the actual height of the physical screen
+   */
+  virtual uint16_t GetHeight() const = 0;
+
+  /**
+   * Return the time needed to write a graphics that changes every pixel of
+   * the screen, in microseconds.
+   */
+  virtual uint32_t GetFrameWriteTimeMicro() const = 0;
+};
+
+}  // namespace ledmatrix
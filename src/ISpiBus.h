@@ -0,0 +1,93 @@
+/**
+ * @file ISpiBus.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Interface for the SPI transport used to talk to the matrices
+ * @version 0.1
+ * @date 2019-06-13
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+namespace ledmatrix {
+
+/**
+ * One message sent on the SPI bus. The chip select of \a channel is active
+ * during the whole message, and released after it.
+ */
+struct SpiTransfer {
+  int channel;
+  const uint8_t* data;
+  uint16_t size;
+};
+
+/**
+ * \a ISpiBus sends messages to the devices connected on the chip selects
+ * (channels) of a SPI bus. Only writes are needed: the received bytes are
+ * dropped.
+ */
+class ISpiBus {
+ public:
+  virtual ~ISpiBus() {}
+
+  /**
+   * Prepare a channel. Must be called once before writing on it.
+   * @param channel the chip select.
+   * @return true on success.
+   */
+  virtual bool Setup(int channel) = 0;
+
+  /**
+   * @return the number of channels: they go from 0 to this number - 1.
+   */
+  virtual int GetNumberOfChannels() const = 0;
+
+  /**
+   * @return the clock frequency of the bus in Hz, 0 for a bus without any
+   * clock (sending a message takes no time).
+   */
+  virtual uint32_t GetSpeedHz() const = 0;
+
+  /**
+   * Send several messages, in order. Implementations send as many of them as
+   * possible at once (e.g. a whole frame or init sequence in one system
+   * call).
+   * @param transfers the messages to send.
+   * @param count number of messages.
+   * @return true if every message was sent.
+   */
+  virtual bool WriteBatch(const SpiTransfer* transfers, uint16_t count) = 0;
+
+  /**
+   * Same as WriteBatch(), except that the messages may be dropped when the bus
+   * is busy. Used for the frames: the caller is expected to send the whole
+   * content of the screen again when it fails.
+   * @param transfers the messages to send.
+   * @param count number of messages.
+   * @return true if every message was sent (or is going to be).
+   */
+  virtual bool TryWriteBatch(const SpiTransfer* transfers, uint16_t count) {
+    return (WriteBatch(transfers, count));
+  }
+
+  /**
+   * Send a single message.
+   * @param channel the chip select.
+   * @param data bytes to send.
+   * @param size number of bytes to send.
+   * @return true if the message was sent.
+   */
+  bool Write(int channel, const uint8_t* data, uint16_t size) {
+    SpiTransfer transfer = {channel, data, size};
+    return (WriteBatch(&transfer, 1));
+  }
+};
+
+}  // namespace ledmatrix
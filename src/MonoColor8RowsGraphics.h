@@ -14,55 +14,31 @@
  */
 #pragma once
 
-#include <bitset>
-#include <vector>
+#include <stdint.h>
 
-#include "src/IGraphics.h"
+#include "src/MonoColorGraphics.h"
 
 /**
- * The horizontal size of the sure electronic HT1632 board.
+ * The vertical size of the sure electronic HT1632 board.
  */
 #define MONO_COLOR_GRAPHICS_NUMBER_OF_ROWS 8
 
 namespace ledmatrix {
 
 /**
- * Represent a single color 8 rows Led Matrix such as the sure electronic
- * HT1632 based led matrix.
+ * Single color 8 rows Led Matrix, the size of one sure electronic HT1632
+ * board.
  */
-class MonoColor8RowsGraphics : public IGraphics {
- public:
-  MonoColor8RowsGraphics();
-  virtual ~MonoColor8RowsGraphics();
+typedef MonoColorGraphics<uint8_t> MonoColor8RowsGraphics;
 
-  // Prevent wrong usage of these operators.
-  MonoColor8RowsGraphics(const MonoColor8RowsGraphics& other) = delete;
-  MonoColor8RowsGraphics& operator=(const MonoColor8RowsGraphics& other) =
-      delete;
-  MonoColor8RowsGraphics(MonoColor8RowsGraphics&& other) = delete;
-  MonoColor8RowsGraphics& operator=(MonoColor8RowsGraphics&& other) = delete;
-  bool operator==(const MonoColor8RowsGraphics& other) const = delete;
-  bool operator!=(const MonoColor8RowsGraphics& other) const = delete;
-
-  /* Pixel operations */
-  virtual void SetPixel(uint16_t x, uint16_t y, bool on);
-  virtual bool GetPixel(uint16_t x, uint16_t y) const;
-
-  /* Full matrix operations */
-  virtual uint16_t GetHeight() const;
-  virtual uint16_t GetWidth() const;
-  virtual void SetWidth(uint16_t width);
-
-  virtual void Clear();
-  virtual void Reset();
-  virtual void Rotate(Direction direction,
-                      uint16_t numberOfRows);
-  virtual void Shift(Direction direction,
-                     uint16_t numberOfRows);
+/**
+ * Single color 16 rows Led Matrix (two boards stacked vertically).
+ */
+typedef MonoColorGraphics<uint16_t> MonoColor16RowsGraphics;
 
- private:
-  std::vector<std::bitset<MONO_COLOR_GRAPHICS_NUMBER_OF_ROWS> > m_matrix;
-  uint16_t m_screenOriginPostion;
-};
+/**
+ * Single color 32 rows Led Matrix (four boards stacked vertically).
+ */
+typedef MonoColorGraphics<uint32_t> MonoColor32RowsGraphics;
 
 }  // namespace ledmatrix
@@ -0,0 +1,307 @@
+/**
+ * @file MonoColorGraphics.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Single color 8 rows Led Matrix
+ * @version 0.1
+ * @date 2019-05-20
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+
+#include "src/MonoColorGraphics.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "spdlog/spdlog.h"
+
+namespace ledmatrix {
+
+template <typename Word>
+MonoColorGraphics<Word>::MonoColorGraphics()
+    : m_head(0), m_size(0), m_screenOriginPostion(0) {}
+
+template <typename Word>
+MonoColorGraphics<Word>::~MonoColorGraphics() {}
+
+template <typename Word>
+void MonoColorGraphics<Word>::SetPixel(uint16_t x, uint16_t y, bool on) {
+  uint32_t position = x + m_screenOriginPostion;
+  if (y >= NUMBER_OF_ROWS) {
+    /*  We are outside of the bounds. That is ok, we just ignore the call
+            and log a message. */
+    spdlog::error(
+        "Tried to set a pixel outside of the bound (at ({}, {}) with a matrix "
+        "of size {}x{}.",
+        position, y, GetWidth(), GetHeight());
+    return;
+  }
+
+  // Increase the size of our matrix in case we are outside the x boundaries
+  if (position >= m_size) {
+    Grow(x + 1);
+    position = x + m_screenOriginPostion;
+  }
+
+  MarkDirty(x, 1);
+  Word& column = m_matrix[GetIndex(position)];
+  if (on) {
+    column |= static_cast<Word>(Word(1) << y);
+  } else {
+    column &= static_cast<Word>(~(Word(1) << y));
+  }
+}
+
+template <typename Word>
+bool MonoColorGraphics<Word>::GetPixel(uint16_t x, uint16_t y) const {
+  uint32_t position = x + m_screenOriginPostion;
+  // Everything outside of the bounds is considered as not set
+  if ((position >= m_size) || (y >= NUMBER_OF_ROWS)) {
+    return (false);
+  }
+  return (0 != (m_matrix[GetIndex(position)] & (Word(1) << y)));
+}
+
+template <typename Word>
+void MonoColorGraphics<Word>::WriteColumns(uint16_t x, uint16_t y,
+                                        const uint8_t* columns,
+                                        uint16_t count) {
+  if ((0 == count) || (y >= NUMBER_OF_ROWS)) {
+    return;
+  }
+  if (x + count + m_screenOriginPostion > m_size) {
+    Grow(x + count);
+  }
+  MarkDirty(x, count);
+
+  uint32_t position = x + m_screenOriginPostion;
+  if ((0 == y) && (1 == sizeof(Word))) {
+    // Whole columns, copy the two contiguous parts of the ring.
+    uint32_t index = GetIndex(position);
+    uint32_t firstPart = std::min<uint32_t>(count, m_matrix.size() - index);
+    memcpy(&m_matrix[index], columns, firstPart);
+    memcpy(&m_matrix[0], columns + firstPart, count - firstPart);
+  } else {
+    Word mask = static_cast<Word>(0xFFu << y);
+    for (uint16_t i = 0; i < count; ++i) {
+      Word& column = m_matrix[GetIndex(position + i)];
+      column = static_cast<Word>((column & ~mask) |
+                                 (static_cast<uint32_t>(columns[i]) << y));
+    }
+  }
+}
+
+template <typename Word>
+void MonoColorGraphics<Word>::ReadColumns(uint16_t x, uint16_t y,
+                                       uint8_t* columns,
+                                       uint16_t count) const {
+  uint32_t position = x + m_screenOriginPostion;
+  uint16_t available = 0;
+  if ((position < m_size) && (y < NUMBER_OF_ROWS)) {
+    available = std::min<uint32_t>(count, m_size - position);
+    if ((0 == y) && (1 == sizeof(Word))) {
+      uint32_t index = GetIndex(position);
+      uint32_t firstPart =
+          std::min<uint32_t>(available, m_matrix.size() - index);
+      memcpy(columns, &m_matrix[index], firstPart);
+      memcpy(columns + firstPart, &m_matrix[0], available - firstPart);
+    } else {
+      for (uint16_t i = 0; i < available; ++i) {
+        columns[i] =
+            static_cast<uint8_t>(m_matrix[GetIndex(position + i)] >> y);
+      }
+    }
+  }
+  // Everything outside of the bounds is considered as not set
+  memset(columns + available, 0, count - available);
+}
+
+template <typename Word>
+void MonoColorGraphics<Word>::FillColumns(uint16_t x, uint16_t y,
+                                       uint16_t count, uint8_t column) {
+  if ((0 == count) || (y >= NUMBER_OF_ROWS)) {
+    return;
+  }
+  if (x + count + m_screenOriginPostion > m_size) {
+    Grow(x + count);
+  }
+  MarkDirty(x, count);
+
+  uint32_t position = x + m_screenOriginPostion;
+  Word mask = static_cast<Word>(0xFFu << y);
+  Word value = static_cast<Word>(static_cast<uint32_t>(column) << y);
+  for (uint16_t i = 0; i < count; ++i) {
+    Word& current = m_matrix[GetIndex(position + i)];
+    current = static_cast<Word>((current & ~mask) | value);
+  }
+}
+
+template <typename Word>
+uint16_t MonoColorGraphics<Word>::GetColumnsView(
+    uint16_t x, uint16_t count, const uint8_t** columns) const {
+  uint32_t position = x + m_screenOriginPostion;
+  // Only byte columns have the layout expected by the callers.
+  if ((1 != sizeof(Word)) || (position >= m_size)) {
+    return (0);
+  }
+  // The view stops at the end of the ring storage, the columns that wrapped
+  // around are given by a second call.
+  uint32_t index = GetIndex(position);
+  *columns = reinterpret_cast<const uint8_t*>(&m_matrix[index]);
+  return (std::min<uint32_t>(std::min<uint32_t>(count, m_size - position),
+                             m_matrix.size() - index));
+}
+
+template <typename Word>
+uint16_t MonoColorGraphics<Word>::GetHeight() const {
+  return (NUMBER_OF_ROWS);
+}
+
+template <typename Word>
+uint16_t MonoColorGraphics<Word>::GetWidth() const {
+  return (std::min<uint32_t>(m_size - m_screenOriginPostion, UINT16_MAX));
+}
+
+template <typename Word>
+void MonoColorGraphics<Word>::SetWidth(uint16_t width) {
+  if (m_size < width + m_screenOriginPostion) {
+    Grow(width);
+  }
+}
+
+template <typename Word>
+void MonoColorGraphics<Word>::Clear() {
+  MarkAllDirty();
+  // The storage is kept, so that the next message does not reallocate it.
+  m_head = 0;
+  m_size = 0;
+  m_screenOriginPostion = 0;
+}
+
+template <typename Word>
+void MonoColorGraphics<Word>::Reset() {
+  MarkAllDirty();
+  std::fill(m_matrix.begin(), m_matrix.end(), 0);
+  m_screenOriginPostion = 0;
+}
+
+template <typename Word>
+void MonoColorGraphics<Word>::Rotate(Direction direction,
+                                     uint16_t numberOfRows) {
+  MarkAllDirty();
+  if ((Right == direction) || (Left == direction)) {
+    if ((0 != numberOfRows) && (m_size != 0)) {
+      // The head can only be moved when the ring is exactly as large as the
+      // stored columns. This reallocation happens once, the following
+      // rotations are free as long as the matrix does not grow.
+      if (m_matrix.size() != m_size) {
+        std::vector<Word> matrix(m_size);
+        for (uint32_t i = 0; i < m_size; ++i) {
+          matrix[i] = m_matrix[GetIndex(i)];
+        }
+        m_matrix.swap(matrix);
+        m_head = 0;
+      }
+
+      uint32_t offset = numberOfRows % m_size;
+      if (Right == direction) {
+        offset = m_size - offset;
+      }
+      m_head = GetIndex(offset);
+    }
+  } else if ((Up == direction) || (Down == direction)) {
+    for (uint32_t i = 0; i < m_size; ++i) {
+      Word& column = m_matrix[GetIndex(i)];
+      // Shifting by the number of rows or more clears the column, as
+      // std::bitset would do.
+      if (numberOfRows >= NUMBER_OF_ROWS) {
+        column = 0;
+      } else if (Up == direction) {
+        column = static_cast<Word>(column << numberOfRows);
+      } else {
+        column = static_cast<Word>(column >> numberOfRows);
+      }
+    }
+  }
+}
+
+template <typename Word>
+void MonoColorGraphics<Word>::Shift(Direction direction,
+                                    uint16_t numberOfRows) {
+  if (0 == m_size) {
+    spdlog::error("Trying to shift a led matrix of size 0.");
+    return;
+  }
+  if (0 != numberOfRows) {
+    MarkShifted(direction, numberOfRows);
+    spdlog::debug("Shifting {} rows to the {}", numberOfRows,
+                  direction == Left ? "left" : "right");
+    if (Right == direction) {
+      // First bring back the columns that were shifted out, then add the
+      // missing blank columns in front of the head.
+      uint32_t restored =
+          std::min<uint32_t>(m_screenOriginPostion, numberOfRows);
+      m_screenOriginPostion -= restored;
+      uint32_t added = numberOfRows - restored;
+      if (0 != added) {
+        Reserve(m_size + added);
+        m_head = GetIndex(m_matrix.size() - added);
+        for (uint32_t i = 0; i < added; ++i) {
+          m_matrix[GetIndex(i)] = 0;
+        }
+        m_size += added;
+      }
+    } else {
+      // Shifting past the last column leaves an empty matrix.
+      m_screenOriginPostion =
+          std::min(m_screenOriginPostion + numberOfRows, m_size);
+    }
+  }
+  spdlog::debug("New size after shift: {}", GetWidth());
+  spdlog::debug("New origin position after shift: {}", m_screenOriginPostion);
+}
+
+template <typename Word>
+void MonoColorGraphics<Word>::Reserve(uint32_t capacity) {
+  if (m_matrix.size() < capacity) {
+    // Grow geometrically so that adding columns one by one stays cheap.
+    std::vector<Word> matrix(
+        std::max<uint32_t>(capacity, 2 * m_matrix.size()), 0);
+    for (uint32_t i = 0; i < m_size; ++i) {
+      matrix[i] = m_matrix[GetIndex(i)];
+    }
+    m_matrix.swap(matrix);
+    m_head = 0;
+  }
+}
+
+template <typename Word>
+void MonoColorGraphics<Word>::Grow(uint32_t width) {
+  // The columns that were shifted out on the left are given back to the ring
+  // before growing it. This only moves the head, and lets an endless
+  // scrolling reuse the same storage instead of growing forever.
+  if (0 != m_screenOriginPostion) {
+    m_head = GetIndex(m_screenOriginPostion);
+    m_size -= m_screenOriginPostion;
+    m_screenOriginPostion = 0;
+  }
+
+  Reserve(width);
+  for (uint32_t i = m_size; i < width; ++i) {
+    m_matrix[GetIndex(i)] = 0;
+  }
+  m_size = width;
+}
+
+// Row counts supported by the mono color graphics.
+template class MonoColorGraphics<uint8_t>;
+template class MonoColorGraphics<uint16_t>;
+template class MonoColorGraphics<uint32_t>;
+
+}  // namespace ledmatrix
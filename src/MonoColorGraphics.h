@@ -0,0 +1,144 @@
+/**
+ * @file MonoColorGraphics.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Single color Led Matrix of 8, 16 or 32 rows
+ * @version 0.1
+ * @date 2019-05-20
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <type_traits>
+#include <vector>
+
+#include "src/AbstractGraphics.h"
+
+namespace ledmatrix {
+
+/**
+ * Represent a single color Led Matrix such as the sure electronic HT1632 based
+ * led matrix. Every column is stored in a single \a Word (bit y is the pixel
+ * at row y), so the number of rows is the number of bits of \a Word: uint8_t
+ * for one panel, uint16_t or uint32_t for panels stacked vertically.
+ *
+ * Columns are stored in a ring buffer with a movable head. Adding columns on
+ * the left (Shift right) only moves the head and horizontal rotations are a
+ * head move as well, so both operations have a cost that does not depend on
+ * the width of the matrix.
+ *
+ * Columns shifted out on the left are kept (a shift to the right brings them
+ * back) until the matrix has to grow on the right. They are then given back
+ * to the ring, so a matrix that keeps scrolling and receiving new columns
+ * uses a constant amount of memory.
+ */
+template <typename Word>
+class MonoColorGraphics : public AbstractGraphics {
+  static_assert(std::is_unsigned<Word>::value && (sizeof(Word) <= 4),
+                "MonoColorGraphics columns are uint8_t, uint16_t or uint32_t");
+
+ public:
+  /**
+   * The number of rows of the matrix.
+   */
+  static const uint16_t NUMBER_OF_ROWS = 8 * sizeof(Word);
+
+  MonoColorGraphics();
+  virtual ~MonoColorGraphics();
+
+  // Prevent wrong usage of these operators.
+  MonoColorGraphics(const MonoColorGraphics& other) = delete;
+  MonoColorGraphics& operator=(const MonoColorGraphics& other) = delete;
+  MonoColorGraphics(MonoColorGraphics&& other) = delete;
+  MonoColorGraphics& operator=(MonoColorGraphics&& other) = delete;
+  bool operator==(const MonoColorGraphics& other) const = delete;
+  bool operator!=(const MonoColorGraphics& other) const = delete;
+
+  /* Pixel operations */
+  virtual void SetPixel(uint16_t x, uint16_t y, bool on);
+  virtual bool GetPixel(uint16_t x, uint16_t y) const;
+
+  /* Column operations */
+  virtual void WriteColumns(uint16_t x, uint16_t y, const uint8_t* columns,
+                            uint16_t count);
+  virtual void ReadColumns(uint16_t x, uint16_t y, uint8_t* columns,
+                           uint16_t count) const;
+  virtual void FillColumns(uint16_t x, uint16_t y, uint16_t count,
+                           uint8_t column);
+  virtual uint16_t GetColumnsView(uint16_t x, uint16_t count,
+                                  const uint8_t** columns) const;
+
+  /* Full matrix operations */
+  virtual uint16_t GetHeight() const;
+  virtual uint16_t GetWidth() const;
+  virtual void SetWidth(uint16_t width);
+
+  virtual void Clear();
+  virtual void Reset();
+  virtual void Rotate(Direction direction,
+                      uint16_t numberOfRows);
+  virtual void Shift(Direction direction,
+                     uint16_t numberOfRows);
+
+ private:
+  /**
+   * Ring storage. Each word is a column, bit y being the pixel at row y. The
+   * capacity of the ring is the size of the vector.
+   */
+  std::vector<Word> m_matrix;
+  /**
+   * Index in m_matrix of the first stored column.
+   */
+  uint32_t m_head;
+  /**
+   * Number of stored columns (including the ones before the screen origin).
+   */
+  uint32_t m_size;
+  /**
+   * Number of stored columns that were shifted out on the left of the screen.
+   */
+  uint32_t m_screenOriginPostion;
+
+  /**
+   * Return the index in m_matrix of the stored column \a position.
+   * @param position position of the column from the head (< m_size).
+   */
+  uint32_t GetIndex(uint32_t position) const {
+    uint32_t index = m_head + position;
+    if (index >= m_matrix.size()) {
+      index -= m_matrix.size();
+    }
+    return (index);
+  }
+
+  /**
+   * Make sure that the ring can hold at least \a capacity columns. The
+   * stored columns are moved to the start of the new storage.
+   * @param capacity minimal number of columns.
+   */
+  void Reserve(uint32_t capacity);
+
+  /**
+   * Increase the width of the matrix to \a width, adding blank columns on the
+   * right. The columns that were shifted out on the left of the screen are
+   * reclaimed first, which resets the screen origin to 0.
+   * @param width new width of the matrix.
+   */
+  void Grow(uint32_t width);
+};
+
+template <typename Word>
+const uint16_t MonoColorGraphics<Word>::NUMBER_OF_ROWS;
+
+extern template class MonoColorGraphics<uint8_t>;
+extern template class MonoColorGraphics<uint16_t>;
+extern template class MonoColorGraphics<uint32_t>;
+
+}  // namespace ledmatrix
@@ -0,0 +1,49 @@
+/**
+ * @file MonoColorGraphicsFactory.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Factory for MonoColorGraphics classes of any height
+ * @version 0.1
+ * @date 2019-06-08
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include "GraphicsFactory.h"
+
+#include <memory>
+
+#include "src/MonoColorGraphics.h"
+
+namespace ledmatrix {
+
+/**
+ * Factory for MonoColorGraphics classes storing their columns in \a Word.
+ */
+template <typename Word>
+class MonoColorGraphicsFactory : public GraphicsFactory {
+ public:
+  MonoColorGraphicsFactory() {}
+  virtual ~MonoColorGraphicsFactory() {}
+
+  // Prevent wrong usage of these operators.
+  MonoColorGraphicsFactory(const MonoColorGraphicsFactory& other) = delete;
+  MonoColorGraphicsFactory& operator=(const MonoColorGraphicsFactory& other) =
+      delete;
+  MonoColorGraphicsFactory(MonoColorGraphicsFactory&& other) = delete;
+  MonoColorGraphicsFactory& operator=(MonoColorGraphicsFactory&& other) =
+      delete;
+  bool operator==(const MonoColorGraphicsFactory& other) const = delete;
+  bool operator!=(const MonoColorGraphicsFactory& other) const = delete;
+
+  virtual std::unique_ptr<IGraphics> GetIGraphics() {
+    return (std::unique_ptr<IGraphics>(new MonoColorGraphics<Word>()));
+  }
+};
+
+}  // namespace ledmatrix
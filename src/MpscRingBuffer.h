@@ -0,0 +1,139 @@
+/**
+ * @file MpscRingBuffer.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Bounded lock free queue between several producers and one consumer
+ * @version 0.1
+ * @date 2019-06-25
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <utility>
+
+namespace ledmatrix {
+
+/**
+ * Queue of at most \a Capacity elements of type \a T, written by any number
+ * of threads and read by one, without any lock.
+ *
+ * Every slot has a sequence number telling whose turn it is: a producer
+ * claims a free slot by moving the push position forward, moves its element
+ * in and hands the slot to the consumer through the sequence number. The
+ * consumer swaps the element out, so that it never allocates nor frees
+ * memory: the previous content of its variable is released by the producer
+ * reusing the slot.
+ */
+template <typename T, uint16_t Capacity>
+class MpscRingBuffer {
+  static_assert((Capacity > 0) && (0 == (Capacity & (Capacity - 1))),
+                "The capacity of a MpscRingBuffer must be a power of two");
+
+ public:
+  MpscRingBuffer() : m_pushPosition(0), m_popPosition(0) {
+    for (uint32_t i = 0; i < Capacity; ++i) {
+      m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+  virtual ~MpscRingBuffer() {}
+
+  // Prevent wrong usage of these operators.
+  MpscRingBuffer(const MpscRingBuffer& other) = delete;
+  MpscRingBuffer& operator=(const MpscRingBuffer& other) = delete;
+  MpscRingBuffer(MpscRingBuffer&& other) = delete;
+  MpscRingBuffer& operator=(MpscRingBuffer&& other) = delete;
+  bool operator==(const MpscRingBuffer& other) const = delete;
+  bool operator!=(const MpscRingBuffer& other) const = delete;
+
+  /**
+   * Producer side, can be called from any thread.
+   * @param value the element to push. It is moved into the queue.
+   * @return false when the queue is full, \a value is left untouched then.
+   */
+  bool TryPush(T&& value) {
+    uint32_t position = m_pushPosition.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot& slot = m_slots[position & INDEX_MASK];
+      int32_t difference = static_cast<int32_t>(
+          slot.sequence.load(std::memory_order_acquire) - position);
+      if (0 == difference) {
+        // The slot is free, claim it unless another producer did first.
+        if (m_pushPosition.compare_exchange_weak(position, position + 1,
+                                                 std::memory_order_relaxed)) {
+          slot.value = std::move(value);
+          slot.sequence.store(position + 1, std::memory_order_release);
+          return (true);
+        }
+      } else if (difference < 0) {
+        // The consumer did not pop the element pushed Capacity times ago.
+        return (false);
+      } else {
+        position = m_pushPosition.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * Consumer side.
+   * @param pValue receives the oldest element. Its previous content is
+   * swapped into the queue.
+   * @return false when no element is ready.
+   */
+  bool TryPop(T* pValue) {
+    uint32_t position = m_popPosition.load(std::memory_order_relaxed);
+    Slot& slot = m_slots[position & INDEX_MASK];
+    if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+      return (false);
+    }
+    using std::swap;
+    swap(*pValue, slot.value);
+    slot.sequence.store(position + Capacity, std::memory_order_release);
+    m_popPosition.store(position + 1, std::memory_order_relaxed);
+    return (true);
+  }
+
+  /**
+   * Can be called from any thread. An element being pushed counts as pushed.
+   * @return true if no element is waiting for the consumer.
+   */
+  bool IsEmpty() const {
+    return (m_popPosition.load(std::memory_order_relaxed) ==
+            m_pushPosition.load(std::memory_order_relaxed));
+  }
+
+ private:
+  static const uint32_t INDEX_MASK = Capacity - 1;
+
+  struct Slot {
+    /**
+     * Position of the next push into this slot when it is free, this
+     * position + 1 once the element is ready to be popped.
+     */
+    std::atomic<uint32_t> sequence;
+    T value;
+  };
+
+  std::array<Slot, Capacity> m_slots;
+  /**
+   * Number of claimed slots, shared by the producers.
+   */
+  std::atomic<uint32_t> m_pushPosition;
+  /**
+   * Number of popped slots, only written by the consumer.
+   */
+  std::atomic<uint32_t> m_popPosition;
+};
+
+template <typename T, uint16_t Capacity>
+const uint32_t MpscRingBuffer<T, Capacity>::INDEX_MASK;
+
+}  // namespace ledmatrix
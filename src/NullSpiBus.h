@@ -0,0 +1,57 @@
+/**
+ * @file NullSpiBus.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief SPI transport dropping every message
+ * @version 0.1
+ * @date 2019-06-15
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <limits>
+
+#include "src/ISpiBus.h"
+
+namespace ledmatrix {
+
+/**
+ * Bus without any device: every message is dropped right away. Used to run
+ * the display pipeline without any hardware.
+ */
+class NullSpiBus : public ISpiBus {
+ public:
+  NullSpiBus() {}
+  virtual ~NullSpiBus() {}
+
+  // Prevent wrong usage of these operators.
+  NullSpiBus(const NullSpiBus& other) = delete;
+  NullSpiBus& operator=(const NullSpiBus& other) = delete;
+  NullSpiBus(NullSpiBus&& other) = delete;
+  NullSpiBus& operator=(NullSpiBus&& other) = delete;
+  bool operator==(const NullSpiBus& other) const = delete;
+  bool operator!=(const NullSpiBus& other) const = delete;
+
+  virtual bool Setup(int channel) {
+    (void)channel;
+    return (true);
+  }
+  virtual int GetNumberOfChannels() const {
+    return (std::numeric_limits<int>::max());
+  }
+  virtual uint32_t GetSpeedHz() const { return (0); }
+  virtual bool WriteBatch(const SpiTransfer* transfers, uint16_t count) {
+    (void)transfers;
+    (void)count;
+    return (true);
+  }
+};
+
+}  // namespace ledmatrix
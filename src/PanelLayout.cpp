@@ -0,0 +1,51 @@
+/**
+ * @file PanelLayout.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Position of the Sure 3208 panels making a screen
+ * @version 0.1
+ * @date 2019-06-16
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+
+#include "src/PanelLayout.h"
+
+#include <algorithm>
+
+namespace ledmatrix {
+
+namespace panel_layout {
+
+PanelLayout CreateRow(uint16_t numberOfPanels) {
+  PanelLayout layout;
+  for (uint16_t i = 0; i < numberOfPanels; ++i) {
+    Panel panel = {i, static_cast<uint16_t>(i * PANEL_WIDTH), 0, Normal};
+    layout.push_back(panel);
+  }
+  return (layout);
+}
+
+uint16_t GetWidth(const PanelLayout& layout) {
+  uint16_t width = 0;
+  for (const Panel& panel : layout) {
+    width = std::max<uint16_t>(width, panel.x + PANEL_WIDTH);
+  }
+  return (width);
+}
+
+uint16_t GetHeight(const PanelLayout& layout) {
+  uint16_t height = 0;
+  for (const Panel& panel : layout) {
+    height = std::max<uint16_t>(height, panel.y + PANEL_HEIGHT);
+  }
+  return (height);
+}
+
+}  // namespace panel_layout
+
+}  // namespace ledmatrix
@@ -0,0 +1,80 @@
+/**
+ * @file PanelLayout.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Position of the Sure 3208 panels making a screen
+ * @version 0.1
+ * @date 2019-06-16
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+namespace ledmatrix {
+
+/**
+ * How a panel is mounted.
+ */
+enum PanelOrientation {
+  Normal,     // Column 0 on the left, row 0 on the top
+  Rotated180  // Upside down: column 0 on the right, row 0 on the bottom
+};
+
+/**
+ * One 32x8 panel (one HT1632 chip) of the screen.
+ */
+struct Panel {
+  /**
+   * SPI channel (chip select) the panel is connected to.
+   */
+  int channel;
+  /**
+   * Position of the top left corner of the panel within the graphics.
+   */
+  uint16_t x;
+  uint16_t y;
+  PanelOrientation orientation;
+};
+
+/**
+ * The panels making a screen, in the order they are written.
+ */
+typedef std::vector<Panel> PanelLayout;
+
+namespace panel_layout {
+
+/**
+ * Size of a single panel.
+ */
+static const uint16_t PANEL_WIDTH = 32;
+static const uint16_t PANEL_HEIGHT = 8;
+
+/**
+ * Create a row of panels: panel n is connected to channel n and shows the
+ * columns 32 * n to 32 * n + 31.
+ * @param numberOfPanels number of panels in the row. The bus needs as many
+ * channels (see ISpiBus::GetNumberOfChannels()).
+ */
+PanelLayout CreateRow(uint16_t numberOfPanels);
+
+/**
+ * @return the width of the graphics shown by the panels.
+ */
+uint16_t GetWidth(const PanelLayout& layout);
+
+/**
+ * @return the height of the graphics shown by the panels.
+ */
+uint16_t GetHeight(const PanelLayout& layout);
+
+}  // namespace panel_layout
+
+}  // namespace ledmatrix
@@ -19,21 +19,81 @@
 
 #include "spdlog/spdlog.h"
 
+#include "src/AsyncSpiBus.h"
+#include "src/FixedGraphicsFactory.h"
+#include "src/PanelLayout.h"
 #include "src/SimpleMessageGraphicsProvider.h"
+#include "src/SpidevSpiBus.h"
+#include "src/Sure3208LedMatrix.h"
 #include "src/TimeGraphicsProvider.h"
 
+namespace {
+
+/**
+ * Size of a single Sure 3208 panel.
+ */
+static const uint16_t SCREEN_WIDTH = 32;
+static const uint16_t SCREEN_HEIGHT = 8;
+
+/**
+ * Create the bus the panels are connected to.
+ * @param isAsync if true, the messages are sent from a writer thread.
+ * @param speedHz clock frequency of the bus.
+ */
+std::unique_ptr<ledmatrix::ISpiBus> CreateSpiBus(bool isAsync,
+                                                 uint32_t speedHz) {
+  std::unique_ptr<ledmatrix::ISpiBus> pSpiBus(
+      new ledmatrix::SpidevSpiBus(speedHz, 0, 8));
+  if (isAsync) {
+    pSpiBus.reset(new ledmatrix::AsyncSpiBus(std::move(pSpiBus)));
+  }
+  return (pSpiBus);
+}
+}  // namespace
+
 namespace ledmatrix {
 
-PiLedMatrix::PiLedMatrix()
-    : hardware(true), pRuntime(new ledmatrix::Runtime()) {
-  // Time provider
-  std::unique_ptr<ledmatrix::GraphicsFactory> pTimeGraphicsFactory =
-      std::move(ledmatrix::GraphicsFactory::CreateFactory(
-          ledmatrix::GraphicsFactory::MonoColor8RowsGraphicsFactoryType));
+PiLedMatrix::PiLedMatrix() : PiLedMatrix(2) {}
+
+PiLedMatrix::PiLedMatrix(uint16_t numberOfPanels)
+    : PiLedMatrix(numberOfPanels, false) {}
+
+PiLedMatrix::PiLedMatrix(uint16_t numberOfPanels, bool isAsyncOutput)
+    : PiLedMatrix(numberOfPanels, isAsyncOutput,
+                  ledmatrix::Sure3208LedMatrix::SPI_SPEED_HZ) {}
+
+PiLedMatrix::PiLedMatrix(uint16_t numberOfPanels, bool isAsyncOutput,
+                         uint32_t spiSpeedHz)
+    : PiLedMatrix(std::unique_ptr<ledmatrix::ILedMatrixDriver>(
+          new ledmatrix::Sure3208LedMatrix(
+              ledmatrix::panel_layout::CreateRow(numberOfPanels),
+              CreateSpiBus(isAsyncOutput, spiSpeedHz)))) {}
+
+PiLedMatrix::PiLedMatrix(std::unique_ptr<ledmatrix::ILedMatrixDriver> pHardware)
+    : m_pMessageProvider(NULL) {
+  // The runtime owns the hardware, which is only initialized once.
+  uint16_t width = pHardware->GetWidth();
+  pRuntime.reset(new ledmatrix::Runtime(std::move(pHardware)));
+
+  // Time provider. The time always fits on the screen, so a screen sized
+  // frame buffer is enough for one or two screens. The clock is centered on
+  // the width of the graphics, which must be the one of the screen: wider
+  // screens use graphics that can take any width.
+  std::unique_ptr<ledmatrix::GraphicsFactory> pTimeGraphicsFactory;
+  if (width > 2 * SCREEN_WIDTH) {
+    pTimeGraphicsFactory = ledmatrix::GraphicsFactory::CreateFactory(
+        ledmatrix::GraphicsFactory::MonoColor8RowsGraphicsFactoryType);
+  } else if (width > SCREEN_WIDTH) {
+    pTimeGraphicsFactory.reset(
+        new ledmatrix::FixedGraphicsFactory<2 * SCREEN_WIDTH, SCREEN_HEIGHT>());
+  } else {
+    pTimeGraphicsFactory.reset(
+        new ledmatrix::FixedGraphicsFactory<SCREEN_WIDTH, SCREEN_HEIGHT>());
+  }
   std::unique_ptr<ledmatrix::IGraphicsProvider> pTimeGraphicsProvider =
       std::unique_ptr<ledmatrix::IGraphicsProvider>(
           new ledmatrix::TimeGraphicsProvider(std::move(pTimeGraphicsFactory),
-                                              hardware.GetWidth()));
+                                              width));
 
   // Message provider
   std::unique_ptr<ledmatrix::GraphicsFactory> pSimpleMessageGraphicsFactory =
@@ -42,7 +102,7 @@ PiLedMatrix::PiLedMatrix()
   std::unique_ptr<ledmatrix::IGraphicsProvider> pSimpleMessageGraphicsProvider =
       std::unique_ptr<ledmatrix::IGraphicsProvider>(
           new ledmatrix::SimpleMessageGraphicsProvider(
-              std::move(pSimpleMessageGraphicsFactory), hardware.GetWidth()));
+              std::move(pSimpleMessageGraphicsFactory), width));
 
   m_pMessageProvider = static_cast<ledmatrix::SimpleMessageGraphicsProvider*>(
       pSimpleMessageGraphicsProvider.get());
@@ -70,6 +130,18 @@ void PiLedMatrix::AddMessage(const std::string& message) const {
   }
 }
 
+void PiLedMatrix::SetBrightness(uint8_t level) const {
+  pRuntime->GetDisplayEffects().SetBrightness(level);
+}
+
+void PiLedMatrix::FadeTo(uint8_t level, uint32_t durationMilli) const {
+  pRuntime->GetDisplayEffects().FadeTo(level, durationMilli);
+}
+
+void PiLedMatrix::Blink(bool on) const {
+  pRuntime->GetDisplayEffects().Blink(on);
+}
+
 void PiLedMatrix::SetLoglevel(const spdlog::level::level_enum& level) const {
   spdlog::set_level(level);
 }
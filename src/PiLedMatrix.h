@@ -19,9 +19,9 @@
 
 #include "spdlog/spdlog.h"
 
+#include "src/ILedMatrixDriver.h"
 #include "src/Runtime.h"
 #include "src/SimpleMessageGraphicsProvider.h"
-#include "src/Sure3208LedMatrix.h"
 
 namespace ledmatrix {
 
@@ -31,10 +31,52 @@ namespace ledmatrix {
 class PiLedMatrix {
  public:
   /**
-   * Constructor. This will start the display (runtime).
+   * Constructor. This will start the display (runtime). Drive two Sure 3208
+   * matrices through spidev.
    */
   PiLedMatrix();
 
+  /**
+   * Constructor. This will start the display (runtime). Drive a row of Sure
+   * 3208 matrices through spidev, matrix n being connected to channel n.
+   * @param numberOfPanels number of matrices in the row, up to the 5 chip
+   * selects of the Pi (see SpidevSpiBus). A longer row is refused, nothing is
+   * shown.
+   */
+  explicit PiLedMatrix(uint16_t numberOfPanels);
+
+  /**
+   * Constructor. This will start the display (runtime). Drive a row of Sure
+   * 3208 matrices through spidev, matrix n being connected to channel n.
+   * @param numberOfPanels number of matrices in the row, up to the 5 chip
+   * selects of the Pi (see SpidevSpiBus). A longer row is refused, nothing is
+   * shown.
+   * @param isAsyncOutput if true, the frames are sent on the SPI bus by a
+   * dedicated writer thread (see AsyncSpiBus) instead of the display thread.
+   */
+  PiLedMatrix(uint16_t numberOfPanels, bool isAsyncOutput);
+
+  /**
+   * Constructor. This will start the display (runtime). Drive a row of Sure
+   * 3208 matrices through spidev, matrix n being connected to channel n.
+   * @param numberOfPanels number of matrices in the row, up to the 5 chip
+   * selects of the Pi (see SpidevSpiBus). A longer row is refused, nothing is
+   * shown.
+   * @param isAsyncOutput if true, the frames are sent on the SPI bus by a
+   * dedicated writer thread (see AsyncSpiBus) instead of the display thread.
+   * @param spiSpeedHz clock frequency of the SPI bus. The grayscale graphics
+   * are only shown when a frame is sent fast enough (see Runtime), e.g. up to
+   * three panels at 2 MHz. Sure3208LedMatrix::SPI_SPEED_HZ by default.
+   */
+  PiLedMatrix(uint16_t numberOfPanels, bool isAsyncOutput,
+              uint32_t spiSpeedHz);
+
+  /**
+   * Constructor. This will start the display (runtime).
+   * @param pHardware the screens to print on.
+   */
+  explicit PiLedMatrix(std::unique_ptr<ILedMatrixDriver> pHardware);
+
   /**
    * Destructor.
    */
@@ -64,6 +106,25 @@ class PiLedMatrix {
    */
   void AddMessage(const std::string& message) const;
 
+  /**
+   * Set the brightness of the screens.
+   * @param level from 0 (least bright) to 15 (most bright).
+   */
+  void SetBrightness(uint8_t level) const;
+
+  /**
+   * Change the brightness of the screens progressively.
+   * @param level from 0 (least bright) to 15 (most bright).
+   * @param durationMilli duration of the transition.
+   */
+  void FadeTo(uint8_t level, uint32_t durationMilli) const;
+
+  /**
+   * Toggle the blinking of the screens.
+   * @param on if true, the screens blink.
+   */
+  void Blink(bool on) const;
+
   /**
    * Set the log level.
    * @param logfilePath Path to the logfile.
@@ -78,7 +139,6 @@ class PiLedMatrix {
   bool IsStarted() const;
 
  private:
-  ledmatrix::Sure3208LedMatrix hardware;
   std::unique_ptr<ledmatrix::Runtime> pRuntime;
   ledmatrix::SimpleMessageGraphicsProvider* m_pMessageProvider;
 };
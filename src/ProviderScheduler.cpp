@@ -0,0 +1,127 @@
+/**
+ * @file ProviderScheduler.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Choose the provider to display
+ * @version 0.1
+ * @date 2019-06-20
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+
+#include "src/ProviderScheduler.h"
+
+#include <utility>
+
+namespace ledmatrix {
+
+ProviderScheduler::ProviderScheduler() : m_numberOfActiveProviders(0) {}
+
+ProviderScheduler::~ProviderScheduler() {}
+
+uint16_t ProviderScheduler::Add(IGraphicsProvider* pProvider) {
+  uint16_t index = static_cast<uint16_t>(m_entries.size());
+  Entry entry;
+  entry.pProvider = pProvider;
+  entry.isActive = false;
+  entry.priority = 0;
+  entry.position = index;
+  m_entries.push_back(entry);
+  m_heap.push_back(index);
+  Update(index);
+  return (index);
+}
+
+void ProviderScheduler::Update(uint16_t index) {
+  Entry& entry = m_entries[index];
+  bool isActive = entry.pProvider->IsActive();
+  if (isActive != entry.isActive) {
+    if (isActive) {
+      ++m_numberOfActiveProviders;
+    } else {
+      --m_numberOfActiveProviders;
+    }
+  }
+  entry.isActive = isActive;
+  entry.priority = entry.pProvider->GetPriority();
+
+  // Only one of them moves the provider.
+  SiftUp(entry.position);
+  SiftDown(entry.position);
+}
+
+void ProviderScheduler::UpdateAll() {
+  for (uint16_t i = 0; i < m_entries.size(); ++i) {
+    Update(i);
+  }
+}
+
+uint16_t ProviderScheduler::GetTop() const {
+  return (m_heap.empty() ? GetSize() : m_heap[0]);
+}
+
+IGraphicsProvider* ProviderScheduler::GetProvider(uint16_t index) const {
+  return (m_entries[index].pProvider);
+}
+
+uint16_t ProviderScheduler::GetNumberOfActiveProviders() const {
+  return (m_numberOfActiveProviders);
+}
+
+uint16_t ProviderScheduler::GetSize() const {
+  return (static_cast<uint16_t>(m_entries.size()));
+}
+
+bool ProviderScheduler::IsBefore(uint16_t left, uint16_t right) const {
+  const Entry& leftEntry = m_entries[left];
+  const Entry& rightEntry = m_entries[right];
+  if (leftEntry.isActive != rightEntry.isActive) {
+    return (leftEntry.isActive);
+  }
+  if (leftEntry.priority != rightEntry.priority) {
+    return (leftEntry.priority > rightEntry.priority);
+  }
+  return (left < right);
+}
+
+void ProviderScheduler::SiftUp(uint16_t position) {
+  while (position > 0) {
+    uint16_t parent = static_cast<uint16_t>((position - 1) / 2);
+    if (!IsBefore(m_heap[position], m_heap[parent])) {
+      return;
+    }
+    Swap(position, parent);
+    position = parent;
+  }
+}
+
+void ProviderScheduler::SiftDown(uint16_t position) {
+  while (true) {
+    uint32_t first = position;
+    uint32_t left = 2 * static_cast<uint32_t>(position) + 1;
+    uint32_t right = left + 1;
+    if ((left < m_heap.size()) && IsBefore(m_heap[left], m_heap[first])) {
+      first = left;
+    }
+    if ((right < m_heap.size()) && IsBefore(m_heap[right], m_heap[first])) {
+      first = right;
+    }
+    if (first == position) {
+      return;
+    }
+    Swap(position, static_cast<uint16_t>(first));
+    position = static_cast<uint16_t>(first);
+  }
+}
+
+void ProviderScheduler::Swap(uint16_t first, uint16_t second) {
+  std::swap(m_heap[first], m_heap[second]);
+  m_entries[m_heap[first]].position = first;
+  m_entries[m_heap[second]].position = second;
+}
+
+}  // namespace ledmatrix
@@ -0,0 +1,120 @@
+/**
+ * @file ProviderScheduler.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Choose the provider to display
+ * @version 0.1
+ * @date 2019-06-20
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "src/IGraphicsProvider.h"
+
+namespace ledmatrix {
+
+/**
+ * Keep the graphics providers ordered the way the runtime chooses them: the
+ * active ones first, then the highest priority (the first added one on a
+ * tie).
+ *
+ * The providers live in an indexed binary heap. The state of a provider
+ * (IsActive() and GetPriority()) is only read by Update(), which moves it in
+ * the heap in O(log n): the caller updates the providers whose state may have
+ * changed, instead of sorting all of them.
+ *
+ * The providers are not owned. Not thread safe.
+ */
+class ProviderScheduler {
+ public:
+  ProviderScheduler();
+  virtual ~ProviderScheduler();
+
+  // Prevent wrong usage of these operators.
+  ProviderScheduler(const ProviderScheduler& other) = delete;
+  ProviderScheduler& operator=(const ProviderScheduler& other) = delete;
+  ProviderScheduler(ProviderScheduler&& other) = delete;
+  ProviderScheduler& operator=(ProviderScheduler&& other) = delete;
+  bool operator==(const ProviderScheduler& other) const = delete;
+  bool operator!=(const ProviderScheduler& other) const = delete;
+
+  /**
+   * Add a provider and read its state.
+   * @param pProvider The provider, it must outlive the scheduler.
+   * @return the index of the provider, used by the other methods.
+   */
+  uint16_t Add(IGraphicsProvider* pProvider);
+
+  /**
+   * Read the state of a provider again.
+   * @param index The index returned by Add().
+   */
+  void Update(uint16_t index);
+
+  /**
+   * Read the state of every provider again.
+   */
+  void UpdateAll();
+
+  /**
+   * @return the index of the provider to display, or GetSize() when there is
+   * none.
+   */
+  uint16_t GetTop() const;
+
+  /**
+   * @param index The index returned by Add().
+   * @return the provider.
+   */
+  IGraphicsProvider* GetProvider(uint16_t index) const;
+
+  /**
+   * @return the number of active providers when they were last updated.
+   */
+  uint16_t GetNumberOfActiveProviders() const;
+
+  /**
+   * @return the number of providers.
+   */
+  uint16_t GetSize() const;
+
+ private:
+  /**
+   * State of a provider, as read by the last update.
+   */
+  struct Entry {
+    IGraphicsProvider* pProvider;
+    bool isActive;
+    unsigned char priority;
+    /**
+     * Position of the provider in m_heap.
+     */
+    uint16_t position;
+  };
+
+  std::vector<Entry> m_entries;
+  /**
+   * Indexes of the providers, the one to display first.
+   */
+  std::vector<uint16_t> m_heap;
+  uint16_t m_numberOfActiveProviders;
+
+  /**
+   * @return true if provider \a left is displayed before provider \a right.
+   */
+  bool IsBefore(uint16_t left, uint16_t right) const;
+  void SiftUp(uint16_t position);
+  void SiftDown(uint16_t position);
+  void Swap(uint16_t first, uint16_t second);
+};
+
+}  // namespace ledmatrix
@@ -14,6 +14,7 @@
  */
 
 #include <src/PiLedMatrix.h>
+#include <src/Sure3208LedMatrix.h>
 
 #include <pybind11/pybind11.h>
 
@@ -35,9 +36,16 @@ PYBIND11_MODULE(_piledmatrix, m) {
       .value("off", spdlog::level::off);
 
   piLedMatrix.def(py::init<>())
+      .def(py::init<uint16_t, bool, uint32_t>(), py::arg("number_of_panels"),
+           py::arg("async_output") = false,
+           py::arg("spi_speed_hz") =
+               ledmatrix::Sure3208LedMatrix::SPI_SPEED_HZ)
       .def("is_started", &ledmatrix::PiLedMatrix::IsStarted)
       .def("start", &ledmatrix::PiLedMatrix::Start)
       .def("stop", &ledmatrix::PiLedMatrix::Stop)
       .def("add_message", &ledmatrix::PiLedMatrix::AddMessage)
+      .def("set_brightness", &ledmatrix::PiLedMatrix::SetBrightness)
+      .def("fade_to", &ledmatrix::PiLedMatrix::FadeTo)
+      .def("blink", &ledmatrix::PiLedMatrix::Blink)
       .def("set_loglevel", &ledmatrix::PiLedMatrix::SetLoglevel);
 }
@@ -0,0 +1,142 @@
+/**
+ * @file RecordingSpiBus.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief SPI transport recording the messages in memory
+ * @version 0.1
+ * @date 2019-06-15
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+
+#include "src/RecordingSpiBus.h"
+
+#include <string.h>
+
+#include "spdlog/spdlog.h"
+
+namespace ledmatrix {
+
+const int RecordingSpiBus::NUMBER_OF_CHANNELS;
+
+namespace {
+
+/**
+ * Read \a count bits of \a data, starting at bit \a position (the most
+ * significant bit of the first byte being bit 0).
+ */
+uint16_t GetBits(const uint8_t* data, uint32_t position, uint16_t count) {
+  uint16_t value = 0;
+  for (uint16_t i = 0; i < count; ++i) {
+    uint32_t bit = position + i;
+    value = (value << 1) | ((data[bit / 8] >> (7 - bit % 8)) & 0x1);
+  }
+  return (value);
+}
+
+/**
+ * Header of the messages writing in the memory of the HT1632.
+ */
+static const uint16_t WRITE_MODE = 0x5;
+
+}  // namespace
+
+RecordingSpiBus::RecordingSpiBus() : RecordingSpiBus(0) {}
+
+RecordingSpiBus::RecordingSpiBus(uint32_t speedHz)
+    : m_speedHz(speedHz), m_numberOfBatches(0) {
+  memset(m_memory, 0, sizeof(m_memory));
+}
+
+RecordingSpiBus::~RecordingSpiBus() {}
+
+bool RecordingSpiBus::Setup(int channel) {
+  if ((channel < 0) || (channel >= NUMBER_OF_CHANNELS)) {
+    spdlog::error("Unsupported SPI channel {}.", channel);
+    return (false);
+  }
+  return (true);
+}
+
+int RecordingSpiBus::GetNumberOfChannels() const {
+  return (NUMBER_OF_CHANNELS);
+}
+
+uint32_t RecordingSpiBus::GetSpeedHz() const {
+  return (m_speedHz);
+}
+
+bool RecordingSpiBus::WriteBatch(const SpiTransfer* transfers,
+                                 uint16_t count) {
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  std::lock_guard<std::mutex> guard(m_mutex);
+  bool success = true;
+  for (uint16_t i = 0; i < count; ++i) {
+    RecordedSpiTransfer transfer;
+    transfer.time = now;
+    transfer.batch = m_numberOfBatches;
+    transfer.channel = transfers[i].channel;
+    transfer.data.assign(transfers[i].data,
+                         transfers[i].data + transfers[i].size);
+    m_transfers.push_back(std::move(transfer));
+
+    if ((transfers[i].channel < 0) ||
+        (transfers[i].channel >= NUMBER_OF_CHANNELS)) {
+      spdlog::error("Writing on unsupported SPI channel {}.",
+                    transfers[i].channel);
+      success = false;
+    } else {
+      Simulate(transfers[i].channel, transfers[i].data, transfers[i].size);
+    }
+  }
+  ++m_numberOfBatches;
+  return (success);
+}
+
+std::vector<RecordedSpiTransfer> RecordingSpiBus::GetTransfers() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return (m_transfers);
+}
+
+void RecordingSpiBus::ClearTransfers() {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_transfers.clear();
+}
+
+void RecordingSpiBus::GetColumns(int channel, uint8_t* columns) const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  // Rows 0 to 3 of a column are at an even address, rows 4 to 7 at the next
+  // one, row 0 being the most significant bit of the nibble.
+  for (uint16_t x = 0; x < ht1632_encoder::NUMBER_OF_COLUMNS; ++x) {
+    uint8_t column = 0;
+    for (uint16_t y = 0; y < 8; ++y) {
+      uint8_t nibble = m_memory[channel][2 * x + y / 4];
+      if (nibble & (0x8 >> (y % 4))) {
+        column |= (0x1 << y);
+      }
+    }
+    columns[x] = column;
+  }
+}
+
+void RecordingSpiBus::Simulate(int channel, const uint8_t* data,
+                               uint16_t size) {
+  // Only the write mode changes the memory: 101, a 7 bits address and as
+  // many nibbles as the message holds, at consecutive addresses.
+  uint32_t numberOfBits = 8 * size;
+  if ((numberOfBits < 10) || (WRITE_MODE != GetBits(data, 0, 3))) {
+    return;
+  }
+  uint16_t address = GetBits(data, 3, 7) % ht1632_encoder::NUMBER_OF_ADDRESSES;
+  for (uint32_t position = 10; position + 4 <= numberOfBits; position += 4) {
+    m_memory[channel][address] =
+        static_cast<uint8_t>(GetBits(data, position, 4));
+    address = (address + 1) % ht1632_encoder::NUMBER_OF_ADDRESSES;
+  }
+}
+
+}  // namespace ledmatrix
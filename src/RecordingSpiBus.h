@@ -0,0 +1,120 @@
+/**
+ * @file RecordingSpiBus.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief SPI transport recording the messages in memory
+ * @version 0.1
+ * @date 2019-06-15
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include "src/Ht1632Encoder.h"
+#include "src/ISpiBus.h"
+
+namespace ledmatrix {
+
+/**
+ * A message sent on a RecordingSpiBus.
+ */
+struct RecordedSpiTransfer {
+  /**
+   * When the message was sent.
+   */
+  std::chrono::steady_clock::time_point time;
+  /**
+   * Number of the batch the message was part of (starting at 0).
+   */
+  uint32_t batch;
+  int channel;
+  std::vector<uint8_t> data;
+};
+
+/**
+ * Bus keeping every message in memory, with the time it was sent. It also
+ * simulates the memory of the HT1632 chips connected on it, so that what
+ * the screens show can be checked.
+ *
+ * The messages can be sent and read from different threads.
+ */
+class RecordingSpiBus : public ISpiBus {
+ public:
+  /**
+   * Constructor. The bus has no clock: GetSpeedHz() returns 0.
+   */
+  RecordingSpiBus();
+
+  /**
+   * Constructor.
+   * @param speedHz clock frequency returned by GetSpeedHz(), the messages are
+   * still recorded at once.
+   */
+  explicit RecordingSpiBus(uint32_t speedHz);
+  virtual ~RecordingSpiBus();
+
+  // Prevent wrong usage of these operators.
+  RecordingSpiBus(const RecordingSpiBus& other) = delete;
+  RecordingSpiBus& operator=(const RecordingSpiBus& other) = delete;
+  RecordingSpiBus(RecordingSpiBus&& other) = delete;
+  RecordingSpiBus& operator=(RecordingSpiBus&& other) = delete;
+  bool operator==(const RecordingSpiBus& other) const = delete;
+  bool operator!=(const RecordingSpiBus& other) const = delete;
+
+  virtual bool Setup(int channel);
+  virtual int GetNumberOfChannels() const;
+  virtual uint32_t GetSpeedHz() const;
+  virtual bool WriteBatch(const SpiTransfer* transfers, uint16_t count);
+
+  /**
+   * @return a copy of the messages recorded so far.
+   */
+  std::vector<RecordedSpiTransfer> GetTransfers() const;
+
+  /**
+   * Forget the messages recorded so far. The simulated chips are kept.
+   */
+  void ClearTransfers();
+
+  /**
+   * Read what the screen connected on a channel shows.
+   * @param channel the chip select (from 0 to NUMBER_OF_CHANNELS - 1).
+   * @param columns receives the NUMBER_OF_COLUMNS columns of the screen, one
+   * byte per column with row 0 in the least significant bit.
+   */
+  void GetColumns(int channel, uint8_t* columns) const;
+
+  /**
+   * Number of simulated chips, as many as the chip selects of the Pi (see
+   * SpidevSpiBus).
+   */
+  static const int NUMBER_OF_CHANNELS = 5;
+
+ private:
+  uint32_t m_speedHz;
+  mutable std::mutex m_mutex;
+  std::vector<RecordedSpiTransfer> m_transfers;
+  uint32_t m_numberOfBatches;
+
+  /**
+   * Memory of the simulated chips, one nibble per address.
+   */
+  uint8_t m_memory[NUMBER_OF_CHANNELS][ht1632_encoder::NUMBER_OF_ADDRESSES];
+
+  /**
+   * Update the memory of a simulated chip with a message.
+   */
+  void Simulate(int channel, const uint8_t* data, uint16_t size);
+};
+
+}  // namespace ledmatrix
@@ -15,7 +15,9 @@
 
 #include "src/Runtime.h"
 
+#include <poll.h>
 #include <pthread.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
 
 #include <algorithm>
@@ -24,28 +26,173 @@
 #include <utility>
 
 #include "spdlog/spdlog.h"
+#include "src/BitPlaneModulator.h"
+#include "src/Sure3208LedMatrix.h"
+
+namespace {
+
+const ledmatrix::ColumnRange ALL_COLUMNS = {0, UINT16_MAX};
+const ledmatrix::ColumnRange NO_COLUMNS = {UINT16_MAX, 0};
+
+/**
+ * Add \a columns to the range pointed by \a pRange.
+ */
+void AddColumns(ledmatrix::ColumnRange* pRange,
+                const ledmatrix::ColumnRange& columns) {
+  if (columns.IsEmpty()) {
+    return;
+  }
+  if (pRange->IsEmpty()) {
+    *pRange = columns;
+  } else {
+    pRange->first = std::min(pRange->first, columns.first);
+    pRange->end = std::max(pRange->end, columns.end);
+  }
+}
+
+/**
+ * Move \a pCycleEnd to the end of the next cycle of \a period. The cycles
+ * keep a fixed rate: a late cycle is caught up, but the cycles missed
+ * entirely are skipped.
+ */
+void NextCycle(std::chrono::high_resolution_clock::time_point* pCycleEnd,
+               std::chrono::milliseconds period) {
+  std::chrono::high_resolution_clock::time_point const now =
+      std::chrono::high_resolution_clock::now();
+  *pCycleEnd += period;
+  if (*pCycleEnd < now) {
+    *pCycleEnd = now + period;
+  }
+}
+
+/**
+ * Wait until the eventfd \a fd is written or \a wakeUpTime is reached, then
+ * reset its counter.
+ */
+void WaitEvent(int fd, std::chrono::steady_clock::time_point wakeUpTime) {
+  std::chrono::steady_clock::duration const sleepTime =
+      wakeUpTime - std::chrono::steady_clock::now();
+  // Rounded up: waking up early would run a pass for nothing.
+  long long timeoutMilli = 0;
+  if (sleepTime > std::chrono::steady_clock::duration::zero()) {
+    timeoutMilli =
+        std::chrono::duration_cast<std::chrono::milliseconds>(sleepTime)
+            .count() +
+        1;
+  }
+  pollfd event = {fd, POLLIN, 0};
+  if (poll(&event, 1, static_cast<int>(timeoutMilli)) > 0) {
+    uint64_t counter;
+    if (read(fd, &counter, sizeof(counter)) < 0) {
+      spdlog::error("Failed to read the compute eventfd: {}",
+                    std::strerror(errno));
+    }
+  }
+}
+
+}  // namespace
 
 namespace ledmatrix {
 
 const unsigned int Runtime::DISPLAY_CYCLE_TIME_MILLI = 15;
 const unsigned int Runtime::COMPUTE_CYCLE_TIME_MILLI = 1000;
+const unsigned int Runtime::TRANSITION_TIME_MILLI = 300;
 
 Runtime::Runtime()
-    : m_bRun(false), m_hardware(true), m_pCurrentGraphicsProvider(NULL) {
-  m_hardware.SetBrightness(15);
+    : Runtime(std::unique_ptr<ILedMatrixDriver>(new Sure3208LedMatrix(true))) {}
+
+Runtime::Runtime(std::unique_ptr<ILedMatrixDriver> pHardware)
+    : m_bRun(false),
+      m_pHardware(std::move(pHardware)),
+      m_isGrayscaleShown(true),
+      m_pCurrentGraphicsProvider(NULL),
+      m_currentGraphicsProviderIndex(UINT16_MAX),
+      m_areAllProvidersChanged(false),
+      m_computeEventFd(eventfd(0, EFD_CLOEXEC)) {
+  // Without the eventfd, the compute thread only runs at its own cycle.
+  if (m_computeEventFd < 0) {
+    spdlog::error("Failed to create the compute eventfd: {}",
+                  std::strerror(errno));
+  }
+  uint16_t frameWidth = decltype(Frame::graphics)::WIDTH;
+  if (m_pHardware->GetWidth() > frameWidth) {
+    spdlog::warn("The screen is {} columns wide, only {} are used.",
+                 m_pHardware->GetWidth(), frameWidth);
+  }
+  // The panels below the frame stay blank.
+  uint16_t frameHeight = decltype(Frame::graphics)::HEIGHT;
+  if (m_pHardware->GetHeight() > frameHeight) {
+    spdlog::error("The screen is {} rows high, only {} are used.",
+                  m_pHardware->GetHeight(), frameHeight);
+  }
+  // Every bit plane of a grayscale frame must be sent within a small part of
+  // a sub-frame, or the planes lose their weights.
+  uint32_t subFrameTimeMicro = DISPLAY_CYCLE_TIME_MILLI * 1000 /
+                               bit_plane_modulator::NUMBER_OF_SUB_FRAMES;
+  uint32_t maxFrameWriteTimeMicro =
+      subFrameTimeMicro / bit_plane_modulator::WRITE_TIME_DIVIDER;
+  uint32_t frameWriteTimeMicro = m_pHardware->GetFrameWriteTimeMicro();
+  if (frameWriteTimeMicro > maxFrameWriteTimeMicro) {
+    m_isGrayscaleShown = false;
+    spdlog::warn(
+        "Writing a frame takes {} us, a grayscale sub-frame ({} us) allows {} "
+        "us: only the single color graphics are shown. A faster SPI clock "
+        "shows the grayscale graphics.",
+        frameWriteTimeMicro, subFrameTimeMicro, maxFrameWriteTimeMicro);
+  }
+  m_effects.Apply(*m_pHardware);
 }
 
 Runtime::~Runtime() {
-  if (m_computeThread.joinable() || m_displayThread.joinable()) {
+  if (m_computeThread.joinable() || m_renderThread.joinable() ||
+      m_displayThread.joinable()) {
     Stop();
   }
   spdlog::info("Clearing all graphic providers");
   m_graphicsProviders.clear();
+  if (m_computeEventFd >= 0) {
+    close(m_computeEventFd);
+  }
 }
 
 void Runtime::AddGraphicsProvider(
     std::unique_ptr<IGraphicsProvider> pGraphicsProvider) {
-  m_graphicsProviders.push_back(std::move(pGraphicsProvider));
+  // The compute thread reads m_graphicsProviders under the same lock and adds
+  // the provider to the scheduler at its next pass. The callback is set
+  // before any other thread can see the provider.
+  {
+    std::lock_guard<std::mutex> guard(m_computeMutex);
+    std::unique_ptr<std::atomic<bool>> pChangedFlag(
+        new std::atomic<bool>(true));
+    std::atomic<bool>* pRawChangedFlag = pChangedFlag.get();
+    pGraphicsProvider->SetStateChangedCallback([this, pRawChangedFlag]() {
+      NotifyProviderStateChanged(pRawChangedFlag);
+    });
+    m_providerChangedFlags.push_back(std::move(pChangedFlag));
+    m_graphicsProviders.push_back(std::move(pGraphicsProvider));
+  }
+  WakeComputeThread();
+}
+
+void Runtime::NotifyStateChanged() {
+  m_areAllProvidersChanged.store(true, std::memory_order_release);
+  WakeComputeThread();
+}
+
+void Runtime::NotifyProviderStateChanged(std::atomic<bool>* pChangedFlag) {
+  pChangedFlag->store(true, std::memory_order_release);
+  WakeComputeThread();
+}
+
+void Runtime::WakeComputeThread() {
+  // The counter of the eventfd keeps the wake ups until the compute thread
+  // waits again: none is lost.
+  uint64_t increment = 1;
+  if ((m_computeEventFd >= 0) &&
+      (write(m_computeEventFd, &increment, sizeof(increment)) < 0)) {
+    spdlog::error("Failed to write the compute eventfd: {}",
+                  std::strerror(errno));
+  }
 }
 
 void Runtime::Start() {
@@ -53,6 +200,8 @@ void Runtime::Start() {
     m_bRun = true;
     m_computeThread = std::move(std::thread(&Runtime::ComputeTask, this));
     pthread_setname_np(m_computeThread.native_handle(), "Runtime_compute");
+    m_renderThread = std::move(std::thread(&Runtime::RenderTask, this));
+    pthread_setname_np(m_renderThread.native_handle(), "Runtime_render");
     m_displayThread = std::move(std::thread(&Runtime::DisplayTask, this));
     pthread_setname_np(m_displayThread.native_handle(), "Runtime_display");
 
@@ -75,10 +224,15 @@ void Runtime::Start() {
 void Runtime::Stop() {
   if (true == m_bRun) {
     m_bRun = false;
+    WakeComputeThread();
     if (m_computeThread.joinable()) {
       m_computeThread.join();
     }
     spdlog::info("Computing thread finished.");
+    if (m_renderThread.joinable()) {
+      m_renderThread.join();
+    }
+    spdlog::info("Render thread finished.");
     if (m_displayThread.joinable()) {
       m_displayThread.join();
     }
@@ -89,24 +243,147 @@ void Runtime::Stop() {
 }
 
 void Runtime::DisplayTask() {
-  unsigned int cycleNumber = 0;
-  IGraphics* pGraphicsToDisplay = NULL;
+  std::chrono::high_resolution_clock::time_point timeout =
+      std::chrono::high_resolution_clock::now();
   while (m_bRun) {
-    std::chrono::high_resolution_clock::time_point const timeout =
-        std::chrono::high_resolution_clock::now() +
-        std::chrono::milliseconds(DISPLAY_CYCLE_TIME_MILLI);
+    NextCycle(&timeout, std::chrono::milliseconds(DISPLAY_CYCLE_TIME_MILLI));
+
+    // The brightness and blinking commands are only a few bytes, they are
+    // sent between two frames.
+    m_effects.Apply(*m_pHardware);
 
-    // First, we display the graphics, this helps avoiding flickering issues
-    // when the ExecuteDisplayCycle method takes non constant time to execute.
-    if (pGraphicsToDisplay) {
-      m_hardware.WriteIGraphics(*pGraphicsToDisplay);
+    // Only the frames that changed are published, there is nothing to do
+    // until the next one, unless the hardware dropped the last one.
+    bool isConsumed = m_frames.Consume();
+    if (!m_frames.GetFrontBuffer().isGrayscale &&
+        (isConsumed || m_pHardware->IsFrameDropped())) {
+      m_pHardware->WriteIGraphics(m_frames.GetFrontBuffer().graphics);
     }
 
-    {
-      std::lock_guard<std::mutex> guard(m_currentGraphicsProviderMutex);
-      if (m_pCurrentGraphicsProvider) {
-        m_pCurrentGraphicsProvider->ExecuteDisplayCycle(cycleNumber);
-        pGraphicsToDisplay = m_pCurrentGraphicsProvider->GetIGraphics();
+    // A grayscale frame is shown again every cycle, one bit plane after the
+    // other. The cycle is split in equal sub-frames.
+    const Frame& frame = m_frames.GetFrontBuffer();
+    if (frame.isGrayscale) {
+      const uint8_t numberOfSubFrames =
+          bit_plane_modulator::NUMBER_OF_SUB_FRAMES;
+      std::chrono::microseconds const subFrameTime(
+          DISPLAY_CYCLE_TIME_MILLI * 1000 / numberOfSubFrames);
+      uint8_t brightness = m_effects.GetAppliedBrightness();
+      for (uint8_t i = 0; i < numberOfSubFrames; ++i) {
+        bit_plane_modulator::WriteSubFrame(
+            *m_pHardware, frame.grayscaleGraphics, i, brightness);
+        std::this_thread::sleep_until(timeout -
+                                      (numberOfSubFrames - 1 - i) *
+                                          subFrameTime);
+      }
+    }
+
+    std::this_thread::sleep_until(timeout);
+  }
+}
+
+void Runtime::RenderTask() {
+  unsigned int cycleNumber = 0;
+  // Last graphics copied into a frame.
+  const IGraphics* pRenderedGraphics = NULL;
+  uint32_t renderedGeneration = 0;
+  // Last published frame.
+  bool bPublished = false;
+  bool bGrayscalePublished = false;
+  uint64_t publishedContentHash = 0;
+  // Columns of the frames that may differ from the last graphics copied. The
+  // frames are told apart by their address, a frame never drawn is entirely
+  // stale.
+  struct StaleColumns {
+    const Frame* pFrame;
+    ColumnRange columns;
+  };
+  StaleColumns staleFrames[3] = {{NULL, ALL_COLUMNS},
+                                 {NULL, ALL_COLUMNS},
+                                 {NULL, ALL_COLUMNS}};
+  std::chrono::high_resolution_clock::time_point timeout =
+      std::chrono::high_resolution_clock::now();
+  while (m_bRun) {
+    NextCycle(&timeout, std::chrono::milliseconds(DISPLAY_CYCLE_TIME_MILLI));
+
+    // The compute thread may switch to another provider meanwhile, this one
+    // is shown until the next cycle.
+    IGraphicsProvider* pCurrentGraphicsProvider =
+        m_pCurrentGraphicsProvider.load(std::memory_order_acquire);
+    if (pCurrentGraphicsProvider) {
+      pCurrentGraphicsProvider->ExecuteDisplayCycle(cycleNumber);
+      IGrayscaleGraphics* pGrayscaleGraphics =
+          m_isGrayscaleShown ? pCurrentGraphicsProvider->GetIGrayscaleGraphics()
+                             : NULL;
+      IGraphics* pGraphics = pCurrentGraphicsProvider->GetIGraphics();
+      if (pGrayscaleGraphics) {
+        // The bit planes are only a few hundred bytes, they are copied
+        // every cycle.
+        Frame& frame = m_frames.GetBackBuffer();
+        frame.grayscaleGraphics.CopyFrom(*pGrayscaleGraphics);
+        frame.isGrayscale = true;
+        pRenderedGraphics = NULL;
+
+        uint64_t contentHash = frame.grayscaleGraphics.GetContentHash();
+        if (!bPublished || !bGrayscalePublished ||
+            (contentHash != publishedContentHash)) {
+          m_frames.Publish();
+          bPublished = true;
+          bGrayscalePublished = true;
+          publishedContentHash = contentHash;
+        }
+      } else if (pGraphics) {
+        // Nothing to copy when the same object has the same generation.
+        uint32_t generation = pGraphics->GetGeneration();
+        if ((pGraphics != pRenderedGraphics) || (0 == generation) ||
+            (generation != renderedGeneration)) {
+          // Only the columns modified since this frame was last drawn are
+          // copied: the ones of the graphics, and the ones modified while
+          // the other frames were drawn.
+          ColumnRange dirtyColumns = ALL_COLUMNS;
+          if ((pGraphics == pRenderedGraphics) && (0 != generation)) {
+            dirtyColumns = pGraphics->GetDirtyColumns();
+          }
+          Frame& frame = m_frames.GetBackBuffer();
+          for (StaleColumns& stale : staleFrames) {
+            if (NULL == stale.pFrame) {
+              // First time this frame is drawn.
+              stale.pFrame = &frame;
+              stale.columns = ALL_COLUMNS;
+              break;
+            } else if (&frame == stale.pFrame) {
+              break;
+            }
+          }
+          ColumnRange copiedColumns = dirtyColumns;
+          for (StaleColumns& stale : staleFrames) {
+            if (&frame == stale.pFrame) {
+              AddColumns(&copiedColumns, stale.columns);
+              stale.columns = NO_COLUMNS;
+            } else {
+              AddColumns(&stale.columns, dirtyColumns);
+            }
+          }
+          if (!copiedColumns.IsEmpty()) {
+            frame.graphics.CopyFrom(*pGraphics, copiedColumns.first,
+                                    copiedColumns.end - copiedColumns.first);
+          }
+          frame.isGrayscale = false;
+          pGraphics->ClearDirtyColumns();
+          pRenderedGraphics = pGraphics;
+          renderedGeneration = generation;
+
+          // A frame identical to the one on the screen (e.g. reset and
+          // redrawn the same way) is not published.
+          uint64_t contentHash = frame.graphics.GetContentHash();
+          if (!bPublished || bGrayscalePublished ||
+              (contentHash != publishedContentHash)) {
+            m_frames.Publish();
+            bPublished = true;
+            bGrayscalePublished = false;
+            publishedContentHash = contentHash;
+          }
+        }
       }
     }
 
@@ -117,28 +394,86 @@ void Runtime::DisplayTask() {
 }
 
 void Runtime::ComputeTask() {
-  unsigned int cycleNumber = 0;
+  // Every provider has its own compute timer.
+  struct ComputeTimer {
+    ComputeTimer() : cycleNumber(0) {}
+    std::chrono::steady_clock::time_point nextCycleTime;
+    unsigned int cycleNumber;
+  };
+  std::vector<ComputeTimer> timers;
+  // Flag of every provider of m_scheduler.
+  std::vector<std::atomic<bool>*> changedFlags;
+
   while (m_bRun) {
-    unsigned int numberOfActiveProviders = 0;
-    if (!m_graphicsProviders.empty()) {
-      // Execute the compute cycle of each graphic provider.
-      std::for_each(m_graphicsProviders.begin(), m_graphicsProviders.end(),
-                    [&](const std::unique_ptr<IGraphicsProvider>& p) {
-                      p->ExecuteComputeCycle(cycleNumber);
-                      if (p->IsActive()) {
-                        numberOfActiveProviders++;
-                      }
-                    });
+    {
+      std::lock_guard<std::mutex> guard(m_computeMutex);
+      // Past this point, the providers are only reached through m_scheduler.
+      while (m_scheduler.GetSize() < m_graphicsProviders.size()) {
+        m_scheduler.Add(m_graphicsProviders[m_scheduler.GetSize()].get());
+      }
+      // The scheduler is kept across restarts, these flags are not.
+      while (changedFlags.size() < m_providerChangedFlags.size()) {
+        changedFlags.push_back(
+            m_providerChangedFlags[changedFlags.size()].get());
+      }
+    }
+    timers.resize(m_scheduler.GetSize());
+
+    std::chrono::steady_clock::time_point const now =
+        std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point wakeUpTime =
+        now + std::chrono::milliseconds(COMPUTE_CYCLE_TIME_MILLI);
+
+    for (uint16_t i = 0; i < m_scheduler.GetSize(); ++i) {
+      // Execute the compute cycle of the graphic providers whose timer
+      // expired (a new provider is due right away). A compute cycle may
+      // change the state of the provider.
+      ComputeTimer& timer = timers[i];
+      if (timer.nextCycleTime <= now) {
+        IGraphicsProvider* p = m_scheduler.GetProvider(i);
+        p->ExecuteComputeCycle(timer.cycleNumber++);
+        m_scheduler.Update(i);
+        std::chrono::milliseconds const period(
+            std::max<uint32_t>(p->GetComputeCycleTimeMilli(), 1));
+        timer.nextCycleTime += period;
+        if (timer.nextCycleTime <= now) {
+          timer.nextCycleTime = now + period;
+        }
+      }
+      wakeUpTime = std::min(wakeUpTime, timer.nextCycleTime);
+    }
+
+    // Only the providers whose state may have changed are read again. A
+    // flag set again from now on is seen by the next pass.
+    bool areAllProvidersChanged =
+        m_areAllProvidersChanged.exchange(false, std::memory_order_acq_rel);
+    for (uint16_t i = 0; i < m_scheduler.GetSize(); ++i) {
+      if (changedFlags[i]->exchange(false, std::memory_order_acq_rel) &&
+          !areAllProvidersChanged) {
+        m_scheduler.Update(i);
+      }
+    }
+    if (areAllProvidersChanged) {
+      m_scheduler.UpdateAll();
+    }
+    if (m_currentGraphicsProviderIndex < m_scheduler.GetSize()) {
+      m_scheduler.Update(m_currentGraphicsProviderIndex);
     }
+    unsigned int numberOfActiveProviders =
+        m_scheduler.GetNumberOfActiveProviders();
 
     spdlog::debug("ComputeTask, number of active providers: {}",
                   numberOfActiveProviders);
     bool bReSchedule = false;
 
+    // Only this thread writes the current provider.
+    IGraphicsProvider* pCurrentGraphicsProvider =
+        m_pCurrentGraphicsProvider.load(std::memory_order_relaxed);
+
     // Reset the current provider if this one has finish.
-    if (m_pCurrentGraphicsProvider) {
-      if ((!m_pCurrentGraphicsProvider->IsActive()) ||
-          (m_pCurrentGraphicsProvider->CanBePreampted() &&
+    if (pCurrentGraphicsProvider) {
+      if ((!pCurrentGraphicsProvider->IsActive()) ||
+          (pCurrentGraphicsProvider->CanBePreampted() &&
            (numberOfActiveProviders > 1))) {
         bReSchedule = true;
       }
@@ -147,29 +482,34 @@ void Runtime::ComputeTask() {
     }
 
     // We need to choose another provider
-    if (bReSchedule && !m_graphicsProviders.empty()) {
-      // Do we have more than one provider in the list ?
-      if (m_graphicsProviders.size() > 1) {
-        spdlog::debug("More than one provider, sorting the array.");
-        IGraphicsProviderPriorityCompare comparator;
-        std::sort(m_graphicsProviders.begin(), m_graphicsProviders.end(),
-                  comparator);
-      }
+    if (bReSchedule && (0 != m_scheduler.GetSize())) {
+      m_currentGraphicsProviderIndex = m_scheduler.GetTop();
 
-      {
-        std::lock_guard<std::mutex> guard(m_currentGraphicsProviderMutex);
-        m_pCurrentGraphicsProvider = m_graphicsProviders[0].get();
+      IGraphicsProvider* pPreviousGraphicsProvider = pCurrentGraphicsProvider;
+      pCurrentGraphicsProvider =
+          m_scheduler.GetProvider(m_currentGraphicsProviderIndex);
+
+      // The render thread never waits for the switch: it picks the new
+      // provider up at its next cycle.
+      m_pCurrentGraphicsProvider.store(pCurrentGraphicsProvider,
+                                       std::memory_order_release);
+
+      // The hardware fades the new provider in, nothing is rendered again.
+      if (pPreviousGraphicsProvider &&
+          (pPreviousGraphicsProvider != pCurrentGraphicsProvider)) {
+        m_effects.FadeIn(TRANSITION_TIME_MILLI);
       }
     }
 
-    if (m_pCurrentGraphicsProvider) {
+    if (pCurrentGraphicsProvider) {
       spdlog::debug("ComputeTask, chosen provider: {}",
-                    m_pCurrentGraphicsProvider->GetName());
+                    pCurrentGraphicsProvider->GetName());
     }
-    ++cycleNumber;
 
-    std::chrono::milliseconds duration(COMPUTE_CYCLE_TIME_MILLI);
-    std::this_thread::sleep_for(duration);
+    // Sleep until the next compute cycle, unless a provider changes before.
+    if (m_bRun) {
+      WaitEvent(m_computeEventFd, wakeUpTime);
+    }
   }
 }
 
@@ -14,13 +14,19 @@
  */
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
 
+#include "src/DisplayEffects.h"
+#include "src/FixedGraphics.h"
+#include "src/GrayscaleGraphics.h"
 #include "src/IGraphicsProvider.h"
-#include "src/Sure3208LedMatrix.h"
+#include "src/ILedMatrixDriver.h"
+#include "src/ProviderScheduler.h"
+#include "src/TripleBuffer.h"
 
 namespace ledmatrix {
 
@@ -30,10 +36,19 @@ namespace ledmatrix {
 class Runtime {
  public:
   /**
-   * Constructor. Will not start the runtime
+   * Constructor. Will not start the runtime. Drive two Sure 3208 matrices
+   * through spidev.
    */
   Runtime();
 
+  /**
+   * Constructor. Will not start the runtime
+   * @param pHardware the screens to print on. Up to 160 columns (the 5
+   * panels of the 5 chip selects in a row) and 32 rows (four rows of panels)
+   * are shown, 8 rows in grayscale.
+   */
+  explicit Runtime(std::unique_ptr<ILedMatrixDriver> pHardware);
+
   /**
    * Destructor. Stop the runtime if it's not already stopped.
    */
@@ -49,24 +64,35 @@ class Runtime {
 
   /**
    * Add another graphics provider to the set of providers. After this
-   * operation, Runtime class will have the ownership of the graphicsProvider
+   * operation, Runtime class will have the ownership of the graphicsProvider.
+   * Can be called from any thread, also while the runtime is started. The
+   * provider must not be used by another thread before it is added.
    * @param pGraphicsProvider A graphicsProvider to add.
    */
   void AddGraphicsProvider(
       std::unique_ptr<IGraphicsProvider> pGraphicsProvider);
 
   /**
-   * Start the Runtime. Two thread are started from here.
+   * Make the compute thread read the state of every provider and choose the
+   * one to display right away, instead of at their next compute cycle. Can be
+   * called from any thread, never waits for the compute thread.
+   */
+  void NotifyStateChanged();
+
+  /**
+   * Start the Runtime. Three thread are started from here.
    * <ul>
    * <li>One to handle the display through SPI. This thread will run a fixed
-   * clock rate.</li> <li>One to handle background tasks such as retrieving
-   * information from Internet.</li>
+   * clock rate and only sends the frames rendered by the next thread.</li>
+   * <li>One to run the display cycles of the current provider and render its
+   * graphics into frames.</li> <li>One to handle background tasks such as
+   * retrieving information from Internet.</li>
    * </ul>
    */
   void Start();
 
   /**
-   * Stop the Runtime. Wait for the two thread to finish properly.
+   * Stop the Runtime. Wait for the threads to finish properly.
    */
   void Stop();
 
@@ -76,30 +102,125 @@ class Runtime {
    */
   bool IsStarted() {return m_bRun;}
 
+  /**
+   * @return the brightness and blinking of the screens. The display thread
+   * applies them between two frames.
+   */
+  DisplayEffects& GetDisplayEffects() { return m_effects; }
+
   /**
    * Cycle time for the display task
    */
   static const unsigned int DISPLAY_CYCLE_TIME_MILLI;
 
   /**
-   * Cycle time for the compute task
+   * Maximum time between two choices of the provider to display, when no
+   * provider notifies a state change and no compute cycle is due.
    */
   static const unsigned int COMPUTE_CYCLE_TIME_MILLI;
 
+  /**
+   * Duration of the fade in when another provider is shown
+   */
+  static const unsigned int TRANSITION_TIME_MILLI;
+
  private:
+  /**
+   * Owner of the providers. Only modified and read under m_computeMutex, the
+   * compute thread copies the new providers into m_scheduler.
+   */
   std::vector<std::unique_ptr<IGraphicsProvider>> m_graphicsProviders;
+  /**
+   * One flag per provider of m_graphicsProviders, set by its state changed
+   * callback and cleared by the compute thread. Every flag has its own
+   * allocation, so that the callbacks keep a valid pointer to it.
+   */
+  std::vector<std::unique_ptr<std::atomic<bool>>> m_providerChangedFlags;
 
   volatile bool m_bRun;
 
-  Sure3208LedMatrix m_hardware;
+  std::unique_ptr<ILedMatrixDriver> m_pHardware;
+
+  DisplayEffects m_effects;
 
-  IGraphicsProvider* m_pCurrentGraphicsProvider;
-  std::mutex m_currentGraphicsProviderMutex;
+  /**
+   * False when the screen is too large for the bit planes to be sent in time:
+   * only the single color graphics of the providers are shown then.
+   */
+  bool m_isGrayscaleShown;
+
+  /**
+   * Provider shown by the render thread. Written by the compute thread only,
+   * read without any lock by the render thread. The providers are owned by
+   * m_graphicsProviders and only destroyed once the threads are stopped, so a
+   * provider that is not current anymore is still valid until the render
+   * thread loads the pointer again.
+   */
+  std::atomic<IGraphicsProvider*> m_pCurrentGraphicsProvider;
+  /**
+   * Index of the current provider in m_scheduler. Only used by the compute
+   * thread.
+   */
+  uint16_t m_currentGraphicsProviderIndex;
+
+  /**
+   * Only taken to add a provider, never by the notifications.
+   */
+  std::mutex m_computeMutex;
+  /**
+   * Set by NotifyStateChanged().
+   */
+  std::atomic<bool> m_areAllProvidersChanged;
+  /**
+   * eventfd waking the compute thread up when a provider changed or when the
+   * runtime stops. Written without any lock: the notifications never wait for
+   * the compute thread.
+   */
+  int m_computeEventFd;
+
+  /**
+   * Order of the providers. Only used by the compute thread.
+   */
+  ProviderScheduler m_scheduler;
+
+  /**
+   * Content of the screen, large enough for any layout of the 5 panels the
+   * driver can reach (see SpidevSpiBus::NUMBER_OF_CHANNELS): a row of 5, or up
+   * to four rows.
+   */
+  struct Frame {
+    Frame() : isGrayscale(false) {}
+
+    FixedGraphics<160, 32> graphics;
+    /**
+     * Shown instead of graphics when isGrayscale is true.
+     */
+    GrayscaleGraphics<160, 8> grayscaleGraphics;
+    bool isGrayscale;
+  };
+
+  /**
+   * Frames rendered by the render thread for the display thread.
+   */
+  TripleBuffer<Frame> m_frames;
 
   std::thread m_computeThread;
+  std::thread m_renderThread;
   std::thread m_displayThread;
 
+  /**
+   * Called by a provider when its state changes.
+   * @param pChangedFlag the flag of the provider in m_providerChangedFlags.
+   */
+  void NotifyProviderStateChanged(std::atomic<bool>* pChangedFlag);
+
+  /**
+   * Make the compute thread run a pass right away.
+   */
+  void WakeComputeThread();
+
   void DisplayTask();
+  void RenderTask();
   void ComputeTask();
 };
 
@@ -32,9 +32,9 @@ const char SimpleMessageGraphicsProvider::PROVIDER_NAME[] = "message";
 
 SimpleMessageGraphicsProvider::SimpleMessageGraphicsProvider(
     std::unique_ptr<GraphicsFactory> pGraphicsFactory, uint16_t graphicsWidth)
-    : m_messageQueueMutex(),
-      m_messageQueue(),
+    : m_messageQueue(),
       m_currentMessage(""),
+      m_isDisplayingMessage(false),
       m_font(),
       m_graphicsWidth(graphicsWidth),
       m_priority(10),
@@ -52,14 +52,14 @@ SimpleMessageGraphicsProvider::~SimpleMessageGraphicsProvider() {}
 void SimpleMessageGraphicsProvider::ExecuteDisplayCycle(
     __attribute__((unused)) unsigned int cycleNumber) {
   if (nullptr != m_pGraphics) {
-    // Find out if a new message is here to be displayed
-    if (m_currentMessage.empty()) {
-      std::lock_guard<std::mutex> guard(m_messageQueueMutex);
-      if (!m_messageQueue.empty()) {
-        m_currentMessage = m_messageQueue.front();
+    // Find out if a new message is here to be displayed. The provider stays
+    // active from the moment the message leaves the queue.
+    if (m_currentMessage.empty() && !m_messageQueue.IsEmpty()) {
+      m_isDisplayingMessage = true;
+      if (m_messageQueue.TryPop(&m_currentMessage)) {
         spdlog::info("Displaying message: {}", m_currentMessage);
-        m_messageQueue.pop();
       }
+      m_isDisplayingMessage = !m_currentMessage.empty();
     }
 
     // Perform animation
@@ -80,9 +80,15 @@ void SimpleMessageGraphicsProvider::ExecuteDisplayCycle(
           m_pAnimation.release();
           m_currentMessage.clear();
           m_pGraphics->Clear();
+          m_isDisplayingMessage = false;
+          if (m_stateChangedCallback) {
+            m_stateChangedCallback();
+          }
         } else {
           spdlog::debug("Animation step for message {}.", m_currentMessage);
           m_pAnimation->PerformStep();
+          // The provider is not active anymore once the last step is shown.
+          m_isDisplayingMessage = !m_pAnimation->IsAnimationDone();
         }
       }
     }
@@ -93,8 +99,21 @@ void SimpleMessageGraphicsProvider::ExecuteComputeCycle(
     __attribute__((unused)) unsigned int cycleNumber) {}
 
 void SimpleMessageGraphicsProvider::DisplayMessage(const std::string& message) {
-  std::lock_guard<std::mutex> guard(m_messageQueueMutex);
-  m_messageQueue.push(message);
+  // The copy is made here, the display cycles only swap strings.
+  std::string messageCopy(message);
+  if (!m_messageQueue.TryPush(std::move(messageCopy))) {
+    spdlog::warn("Too many messages waiting, dropping message: {}", message);
+    return;
+  }
+  // The message is shown as soon as the runtime chooses this provider.
+  if (m_stateChangedCallback) {
+    m_stateChangedCallback();
+  }
+}
+
+void SimpleMessageGraphicsProvider::SetStateChangedCallback(
+    const std::function<void()>& callback) {
+  m_stateChangedCallback = callback;
 }
 
 IGraphics* SimpleMessageGraphicsProvider::GetIGraphics() const {
@@ -102,8 +121,7 @@ IGraphics* SimpleMessageGraphicsProvider::GetIGraphics() const {
 }
 
 bool SimpleMessageGraphicsProvider::IsActive() const {
-  return (!m_messageQueue.empty() ||
-          (m_pAnimation && (!m_pAnimation->IsAnimationDone())));
+  return (!m_messageQueue.IsEmpty() || m_isDisplayingMessage);
 }
 
 unsigned char SimpleMessageGraphicsProvider::GetPriority() const {
@@ -14,16 +14,17 @@
  */
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
-#include <queue>
-#include <mutex>
 
 #include "src/Font8x5.h"
 #include "src/GraphicsFactory.h"
 #include "src/IGraphicsProvider.h"
 #include "src/IGraphicsAnimation.h"
+#include "src/MpscRingBuffer.h"
 
 namespace ledmatrix {
 
@@ -69,12 +70,14 @@ class SimpleMessageGraphicsProvider : public IGraphicsProvider {
   void ExecuteDisplayCycle(unsigned int cycleNumber);
 
   /**
-   * Add a message to the message queue.
+   * Add a message to the message queue. Can be called from any thread, never
+   * waits for the display. The message is dropped when the queue is full.
    * @param message The message to be displayed.
    */
   void DisplayMessage(const std::string& message);
 
   IGraphics* GetIGraphics() const;
+  virtual void SetStateChangedCallback(const std::function<void()>& callback);
   virtual bool IsActive() const;
   virtual bool CanBePreampted() const;
   virtual unsigned char GetPriority() const;
@@ -83,12 +86,27 @@ class SimpleMessageGraphicsProvider : public IGraphicsProvider {
  private:
   std::unique_ptr<IGraphics> m_pGraphics;
 
-  std::mutex m_messageQueueMutex;
-  std::queue<std::string> m_messageQueue;
+  /**
+   * Maximum number of messages waiting to be displayed.
+   */
+  static const uint16_t MESSAGE_QUEUE_SIZE = 32;
+
+  MpscRingBuffer<std::string, MESSAGE_QUEUE_SIZE> m_messageQueue;
   std::string m_currentMessage;
+  /**
+   * Set by the display cycles while a message is taken from the queue and
+   * animated, so that IsActive() can be called from another thread.
+   */
+  std::atomic<bool> m_isDisplayingMessage;
 
   std::unique_ptr<IGraphicsAnimation> m_pAnimation;
 
+  /**
+   * Called when a message arrives and when it has been displayed. Set once
+   * before the provider is shared, then only read.
+   */
+  std::function<void()> m_stateChangedCallback;
+
   Font8x5 m_font;
   uint16_t m_graphicsWidth;
 
@@ -0,0 +1,129 @@
+/**
+ * @file SpidevSpiBus.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief SPI transport built on the Linux spidev driver
+ * @version 0.1
+ * @date 2019-06-13
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+
+#include "src/SpidevSpiBus.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/spi/spidev.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "spdlog/spdlog.h"
+
+namespace ledmatrix {
+
+const uint16_t SpidevSpiBus::MAX_TRANSFERS_PER_CALL;
+const int SpidevSpiBus::NUMBER_OF_CHANNELS;
+
+SpidevSpiBus::SpidevSpiBus(uint32_t speed, uint8_t mode, uint8_t bitsPerWord)
+    : m_speed(speed), m_mode(mode), m_bitsPerWord(bitsPerWord) {
+  for (int& fd : m_fds) {
+    fd = -1;
+  }
+}
+
+SpidevSpiBus::~SpidevSpiBus() {
+  for (int& fd : m_fds) {
+    if (fd >= 0) {
+      close(fd);
+      fd = -1;
+    }
+  }
+}
+
+bool SpidevSpiBus::Setup(int channel) {
+  if ((channel < 0) || (channel >= NUMBER_OF_CHANNELS)) {
+    spdlog::error("Unsupported SPI channel {}.", channel);
+    return (false);
+  }
+  if (m_fds[channel] >= 0) {
+    return (true);
+  }
+
+  int controller = (channel < 2) ? 0 : 1;
+  int chipSelect = (channel < 2) ? channel : channel - 2;
+  std::string device = "/dev/spidev" + std::to_string(controller) + "." +
+                       std::to_string(chipSelect);
+  spdlog::info("Opening {} at {} Hz (mode {}, {} bits per word)", device,
+               m_speed, static_cast<int>(m_mode),
+               static_cast<int>(m_bitsPerWord));
+  int fd = open(device.c_str(), O_RDWR);
+  if (fd < 0) {
+    spdlog::error("Failed to open {}: {}", device, strerror(errno));
+    return (false);
+  }
+  if ((ioctl(fd, SPI_IOC_WR_MODE, &m_mode) < 0) ||
+      (ioctl(fd, SPI_IOC_WR_BITS_PER_WORD, &m_bitsPerWord) < 0) ||
+      (ioctl(fd, SPI_IOC_WR_MAX_SPEED_HZ, &m_speed) < 0)) {
+    spdlog::error("Failed to configure {}: {}", device, strerror(errno));
+    close(fd);
+    return (false);
+  }
+  m_fds[channel] = fd;
+  return (true);
+}
+
+int SpidevSpiBus::GetNumberOfChannels() const {
+  return (NUMBER_OF_CHANNELS);
+}
+
+uint32_t SpidevSpiBus::GetSpeedHz() const {
+  return (m_speed);
+}
+
+bool SpidevSpiBus::WriteBatch(const SpiTransfer* transfers, uint16_t count) {
+  bool success = true;
+  struct spi_ioc_transfer messages[MAX_TRANSFERS_PER_CALL];
+  uint16_t i = 0;
+  while (i < count) {
+    // Group the consecutive messages of the same channel.
+    int channel = transfers[i].channel;
+    uint16_t numberOfMessages = 0;
+    memset(messages, 0, sizeof(messages));
+    while ((i < count) && (transfers[i].channel == channel) &&
+           (numberOfMessages < MAX_TRANSFERS_PER_CALL)) {
+      struct spi_ioc_transfer& message = messages[numberOfMessages];
+      message.tx_buf = reinterpret_cast<uintptr_t>(transfers[i].data);
+      message.len = transfers[i].size;
+      message.speed_hz = m_speed;
+      message.bits_per_word = m_bitsPerWord;
+      // Every message is a command of its own: release the chip select
+      // after it (the last one of the call releases it anyway).
+      message.cs_change = 1;
+      ++numberOfMessages;
+      ++i;
+    }
+    messages[numberOfMessages - 1].cs_change = 0;
+
+    if ((channel < 0) || (channel >= NUMBER_OF_CHANNELS) ||
+        (m_fds[channel] < 0)) {
+      spdlog::error("Writing on SPI channel {} which is not set up.",
+                    channel);
+      success = false;
+    } else if (ioctl(m_fds[channel], SPI_IOC_MESSAGE(numberOfMessages),
+                     messages) < 0) {
+      spdlog::error("SPI write on channel {} failed: {}", channel,
+                    strerror(errno));
+      success = false;
+    }
+  }
+  return (success);
+}
+
+}  // namespace ledmatrix
@@ -0,0 +1,73 @@
+/**
+ * @file SpidevSpiBus.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief SPI transport built on the Linux spidev driver
+ * @version 0.1
+ * @date 2019-06-13
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "src/ISpiBus.h"
+
+namespace ledmatrix {
+
+/**
+ * Talk to the devices through spidev. Channels 0 and 1 are the chip selects of
+ * the main SPI controller of the Pi (/dev/spidev0.0 and /dev/spidev0.1),
+ * channels 2 to 4 the ones of the auxiliary controller (/dev/spidev1.0 to
+ * /dev/spidev1.2). The consecutive messages of a channel are sent with a
+ * single SPI_IOC_MESSAGE system call, the chip select being released between
+ * them.
+ */
+class SpidevSpiBus : public ISpiBus {
+ public:
+  /**
+   * Constructor. The channels are opened by Setup().
+   * @param speed clock frequency in Hz.
+   * @param mode SPI mode (clock polarity and phase, from 0 to 3).
+   * @param bitsPerWord size of the words.
+   */
+  SpidevSpiBus(uint32_t speed, uint8_t mode, uint8_t bitsPerWord);
+  virtual ~SpidevSpiBus();
+
+  // Prevent wrong usage of these operators.
+  SpidevSpiBus() = delete;
+  SpidevSpiBus(const SpidevSpiBus& other) = delete;
+  SpidevSpiBus& operator=(const SpidevSpiBus& other) = delete;
+  SpidevSpiBus(SpidevSpiBus&& other) = delete;
+  SpidevSpiBus& operator=(SpidevSpiBus&& other) = delete;
+  bool operator==(const SpidevSpiBus& other) const = delete;
+  bool operator!=(const SpidevSpiBus& other) const = delete;
+
+  virtual bool Setup(int channel);
+  virtual int GetNumberOfChannels() const;
+  virtual uint32_t GetSpeedHz() const;
+  virtual bool WriteBatch(const SpiTransfer* transfers, uint16_t count);
+
+  /**
+   * Maximum number of messages sent with a single system call.
+   */
+  static const uint16_t MAX_TRANSFERS_PER_CALL = 64;
+
+ private:
+  static const int NUMBER_OF_CHANNELS = 5;
+
+  uint32_t m_speed;
+  uint8_t m_mode;
+  uint8_t m_bitsPerWord;
+  /**
+   * File descriptor of each channel, -1 when not opened.
+   */
+  int m_fds[NUMBER_OF_CHANNELS];
+};
+
+}  // namespace ledmatrix
@@ -0,0 +1,129 @@
+/**
+ * @file SpscRingBuffer.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Bounded lock free queue between one producer and one consumer
+ * @version 0.1
+ * @date 2019-06-14
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+
+namespace ledmatrix {
+
+/**
+ * Queue of at most \a Capacity elements of type \a T, written by one thread
+ * and read by another one, without any lock.
+ *
+ * The elements are used in place: the producer fills the slot returned by
+ * GetWriteSlot() and pushes it, the consumer reads the slot returned by
+ * GetReadSlot() and pops it. A slot is never used by both threads at the same
+ * time.
+ */
+template <typename T, uint16_t Capacity>
+class SpscRingBuffer {
+  static_assert((Capacity > 0) && (0 == (Capacity & (Capacity - 1))),
+                "The capacity of a SpscRingBuffer must be a power of two");
+
+ public:
+  SpscRingBuffer() : m_head(0), m_tail(0) {}
+  virtual ~SpscRingBuffer() {}
+
+  // Prevent wrong usage of these operators.
+  SpscRingBuffer(const SpscRingBuffer& other) = delete;
+  SpscRingBuffer& operator=(const SpscRingBuffer& other) = delete;
+  SpscRingBuffer(SpscRingBuffer&& other) = delete;
+  SpscRingBuffer& operator=(SpscRingBuffer&& other) = delete;
+  bool operator==(const SpscRingBuffer& other) const = delete;
+  bool operator!=(const SpscRingBuffer& other) const = delete;
+
+  /**
+   * Producer side. The number of free slots can only grow until the next
+   * call to Push().
+   * @return the number of slots that can be pushed.
+   */
+  uint16_t GetFreeSlots() const {
+    return (static_cast<uint16_t>(
+        Capacity - (m_head.load(std::memory_order_relaxed) -
+                    m_tail.load(std::memory_order_acquire))));
+  }
+
+  /**
+   * Producer side.
+   * @return the slot to fill before calling Push(), NULL when the queue is
+   * full.
+   */
+  T* GetWriteSlot() {
+    if (0 == GetFreeSlots()) {
+      return (NULL);
+    }
+    return (&m_slots[m_head.load(std::memory_order_relaxed) & INDEX_MASK]);
+  }
+
+  /**
+   * Producer side. Make the slot returned by GetWriteSlot() available to the
+   * consumer.
+   */
+  void Push() {
+    m_head.store(m_head.load(std::memory_order_relaxed) + 1,
+                 std::memory_order_release);
+  }
+
+  /**
+   * Consumer side.
+   * @return the oldest pushed slot, NULL when the queue is empty.
+   */
+  T* GetReadSlot() {
+    uint32_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail == m_head.load(std::memory_order_acquire)) {
+      return (NULL);
+    }
+    return (&m_slots[tail & INDEX_MASK]);
+  }
+
+  /**
+   * Consumer side. Give the slot returned by GetReadSlot() back to the
+   * producer.
+   */
+  void Pop() {
+    m_tail.store(m_tail.load(std::memory_order_relaxed) + 1,
+                 std::memory_order_release);
+  }
+
+  /**
+   * Can be called from both sides.
+   * @return true if no slot is waiting for the consumer.
+   */
+  bool IsEmpty() const {
+    return (m_tail.load(std::memory_order_acquire) ==
+            m_head.load(std::memory_order_acquire));
+  }
+
+ private:
+  static const uint32_t INDEX_MASK = Capacity - 1;
+
+  std::array<T, Capacity> m_slots;
+  /**
+   * Number of pushed slots, only written by the producer.
+   */
+  std::atomic<uint32_t> m_head;
+  /**
+   * Number of popped slots, only written by the consumer.
+   */
+  std::atomic<uint32_t> m_tail;
+};
+
+template <typename T, uint16_t Capacity>
+const uint32_t SpscRingBuffer<T, Capacity>::INDEX_MASK;
+
+}  // namespace ledmatrix
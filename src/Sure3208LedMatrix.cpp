@@ -21,41 +21,146 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <cstdlib>
+#include <set>
 
 #include "spdlog/spdlog.h"
+#include "src/Ht1632Encoder.h"
 #include "src/IGraphics.h"
-#include "wiringPiSPI.h"
+#include "src/PanelLayout.h"
+#include "src/SpidevSpiBus.h"
+
+namespace {
+
+/**
+ * Mirror the rows of a column.
+ */
+uint8_t ReverseBits(uint8_t value) {
+  value = static_cast<uint8_t>((value & 0xf0) >> 4 | (value & 0x0f) << 4);
+  value = static_cast<uint8_t>((value & 0xcc) >> 2 | (value & 0x33) << 2);
+  value = static_cast<uint8_t>((value & 0xaa) >> 1 | (value & 0x55) << 1);
+  return (value);
+}
+
+/**
+ * @return \a layout if every panel has its own channel among the first
+ * \a numberOfChannels ones. Otherwise, the screen cannot be shown as a whole:
+ * the layout is refused and no panel is driven.
+ */
+ledmatrix::PanelLayout GetDrivenPanels(const ledmatrix::PanelLayout &layout,
+                                       int numberOfChannels) {
+  bool isValid = true;
+  std::set<int> channels;
+  for (const ledmatrix::Panel &panel : layout) {
+    if ((panel.channel < 0) || (panel.channel >= numberOfChannels)) {
+      spdlog::error("No SPI channel {} for the panel at ({}, {}), the bus has "
+                    "{}.",
+                    panel.channel, panel.x, panel.y, numberOfChannels);
+      isValid = false;
+    } else if (!channels.insert(panel.channel).second) {
+      spdlog::error("Several panels are connected to SPI channel {}.",
+                    panel.channel);
+      isValid = false;
+    }
+  }
+  if (!isValid) {
+    spdlog::critical("The panel layout cannot be shown: no panel is driven.");
+    return (ledmatrix::PanelLayout());
+  }
+  return (layout);
+}
+
+}  // namespace
 
 namespace ledmatrix {
-Sure3208LedMatrix::Sure3208LedMatrix(bool isDouble) : m_isDouble(isDouble) {
-  InitChannel(0);
-  if (isDouble) {
-    InitChannel(1);
+const uint32_t Sure3208LedMatrix::SPI_SPEED_HZ = 256 * 1024;
+
+Sure3208LedMatrix::Sure3208LedMatrix(bool isDouble)
+    : Sure3208LedMatrix(isDouble, std::unique_ptr<ISpiBus>(
+                                      new SpidevSpiBus(SPI_SPEED_HZ, 0, 8))) {}
+
+Sure3208LedMatrix::Sure3208LedMatrix(bool isDouble,
+                                     std::unique_ptr<ISpiBus> pSpiBus)
+    : Sure3208LedMatrix(panel_layout::CreateRow(isDouble ? 2 : 1),
+                        std::move(pSpiBus)) {}
+
+Sure3208LedMatrix::Sure3208LedMatrix(const PanelLayout &layout)
+    : Sure3208LedMatrix(layout, std::unique_ptr<ISpiBus>(
+                                    new SpidevSpiBus(SPI_SPEED_HZ, 0, 8))) {}
+
+Sure3208LedMatrix::Sure3208LedMatrix(const PanelLayout &layout,
+                                     std::unique_ptr<ISpiBus> pSpiBus)
+    : m_layout(GetDrivenPanels(layout, pSpiBus->GetNumberOfChannels())),
+      m_pSpiBus(std::move(pSpiBus)),
+      m_panelStates(m_layout.size()),
+      m_data(m_layout.size() * ht1632_encoder::MAX_NUMBER_OF_BURSTS *
+             ht1632_encoder::FRAME_SIZE),
+      m_transfers(m_layout.size() * ht1632_encoder::MAX_NUMBER_OF_BURSTS),
+      m_commandData(m_layout.size() * COMMAND_SIZE) {
+  for (PanelState &state : m_panelStates) {
+    state.isLastDataValid = false;
   }
+  m_isInitialized = Init() && (m_layout.size() == layout.size());
   Clear();
 }
 
 Sure3208LedMatrix::~Sure3208LedMatrix() {}
 
 void Sure3208LedMatrix::Clear() {
-  Clear(0);
-  if (m_isDouble) {
-    Clear(1);
+  // The screens are blank from now on, so are their shadow copies.
+  for (uint16_t i = 0; i < m_layout.size(); ++i) {
+    PanelState &state = m_panelStates[i];
+    memset(state.lastColumns, 0, MATRIX_WIDTH);
+    ht1632_encoder::Encode(state.lastColumns, state.lastData);
+    state.isLastDataValid = true;
+    m_transfers[i].channel = m_layout[i].channel;
+    m_transfers[i].data = state.lastData;
+    m_transfers[i].size = ht1632_encoder::FRAME_SIZE;
   }
+  m_pSpiBus->WriteBatch(m_transfers.data(), m_layout.size());
 }
 
 void Sure3208LedMatrix::WriteIGraphics(const IGraphics &graphics) {
-  WriteIGraphics(0, 0, graphics);
-  if (m_isDouble) {
-    WriteIGraphics(1, 32, graphics);
+  int16_t scrollHint = graphics.GetScrollHint();
+
+  // The panels do not share anything but the bus: each one is encoded in its
+  // own part of the buffers, then the messages of all the panels are sent at
+  // once. A panel already showing its window is compared with its shadow copy
+  // and sends nothing.
+  uint16_t numberOfTransfers = 0;
+  for (uint16_t i = 0; i < m_layout.size(); ++i) {
+    PanelState &state = m_panelStates[i];
+    state.numberOfTransfers = EncodeIGraphics(
+        i, graphics, scrollHint,
+        &m_data[i * ht1632_encoder::MAX_NUMBER_OF_BURSTS *
+                ht1632_encoder::FRAME_SIZE],
+        &m_transfers[numberOfTransfers]);
+    numberOfTransfers += state.numberOfTransfers;
+  }
+
+  // The bus may drop a frame when it is busy: the screens do not show their
+  // shadow copy then, and are entirely written next time.
+  if ((0 != numberOfTransfers) &&
+      !m_pSpiBus->TryWriteBatch(m_transfers.data(), numberOfTransfers)) {
+    for (PanelState &state : m_panelStates) {
+      if (0 != state.numberOfTransfers) {
+        state.isLastDataValid = false;
+      }
+    }
   }
 }
 
-void Sure3208LedMatrix::SetBrightness(unsigned char level) {
-  SendCommand(0, COMMAND_PWM_DUTY | level);
-  if (m_isDouble) {
-    SendCommand(1, COMMAND_PWM_DUTY | level);
+bool Sure3208LedMatrix::IsFrameDropped() const {
+  for (const PanelState &state : m_panelStates) {
+    if (!state.isLastDataValid) {
+      return (true);
+    }
   }
+  return (false);
+}
+
+void Sure3208LedMatrix::SetBrightness(unsigned char level) {
+  SendCommand(COMMAND_PWM_DUTY | level);
 }
 
 void Sure3208LedMatrix::Blink(bool on) {
@@ -67,114 +172,158 @@ void Sure3208LedMatrix::Blink(bool on) {
     commandToSend = COMMAND_BLINK_OFF;
   }
 
-  SendCommand(0, commandToSend);
-
-  if (m_isDouble) {
-    SendCommand(1, commandToSend);
-  }
+  SendCommand(commandToSend);
 }
 
-void Sure3208LedMatrix::WriteIGraphics(int channel, uint16_t firstX,
-                                       const IGraphics &graphics) {
-  unsigned char data[34];
+uint16_t Sure3208LedMatrix::EncodeIGraphics(uint16_t index,
+                                            const IGraphics &graphics,
+                                            int16_t scrollHint, uint8_t *data,
+                                            SpiTransfer *transfers) {
+  const Panel &panel = m_layout[index];
 
-  // Set all pixel to OFF by default.
-  memset(data, 0, sizeof(data));
-
-  data[0] = 0xa0;  // 0x10100000 101 is the command and 00000 are the first 5
-                   // bits of the address.
-  data[1] = 0x00;  // 0x00000000 the two first bits are the end of the address.
-                   // The remaining 6 bits will be filled later on.
-
-  uint16_t dataIndex = 1;
-  uint16_t positionWithinWord = 5;
-  for (uint16_t x = firstX; x < firstX + MATRIX_WIDTH; ++x) {
-    for (uint16_t y = 0; y < graphics.GetHeight(); ++y) {
-      if (graphics.GetPixel(x, y)) {
-        data[dataIndex] |= (0x1 << positionWithinWord);
-      }
-
-      if (0 == positionWithinWord) {
-        positionWithinWord = 7;
-        ++dataIndex;
-      } else {
-        --positionWithinWord;
+  // Encode the window straight from the storage of the graphics when it gives
+  // access to it, and fall back on a copy otherwise.
+  uint8_t buffer[MATRIX_WIDTH];
+  const uint8_t *columns = NULL;
+  bool isViewed = (Normal == panel.orientation) && (0 == panel.y) &&
+                  (graphics.GetColumnsView(panel.x, MATRIX_WIDTH, &columns) ==
+                   MATRIX_WIDTH);
+  if (!isViewed) {
+    graphics.ReadColumns(panel.x, panel.y, buffer, MATRIX_WIDTH);
+    if (Rotated180 == panel.orientation) {
+      // The panel shows the window upside down, and scrolls the other way.
+      std::reverse(buffer, buffer + MATRIX_WIDTH);
+      for (uint8_t &column : buffer) {
+        column = ReverseBits(column);
       }
+      scrollHint = -scrollHint;
     }
+    columns = buffer;
   }
-  /* Nasty overlap with the last data index. The problem is that
-   * our SPI driver let us only send word (8 bits). The matrix
-   * has a maximum size of 32 * 8 pixel = 256. On top of that,
-   * we are sending the command header (header + address), which is
-   * composed of 3 bits for the command (101) and 7 bits for the
-   * address. 10 bits in total, which let us 6 bits unused a the
-   * end of our data array. We have to fill them correctly.
-   */
-
-  positionWithinWord = 5;
-  for (uint16_t y = 0; y < 6; ++y) {
-    if (graphics.GetPixel(firstX, y)) {
-      data[33] |= (0x1 << positionWithinWord);
+
+  // The shadow copy holds what the screen shows: nothing to send when it
+  // already shows these columns, and only the modified addresses otherwise.
+  PanelState &state = m_panelStates[index];
+  uint8_t *lastColumns = state.lastColumns;
+  unsigned char *lastData = state.lastData;
+  ht1632_encoder::Burst bursts[ht1632_encoder::MAX_NUMBER_OF_BURSTS];
+  uint16_t numberOfBursts = 1;
+  bursts[0].firstAddress = 0;
+  bursts[0].numberOfNibbles = ht1632_encoder::NUMBER_OF_ADDRESSES;
+  if (state.isLastDataValid) {
+    numberOfBursts = ht1632_encoder::PlanBursts(lastColumns, columns, bursts);
+    if (0 == numberOfBursts) {
+      return (0);
     }
-    --positionWithinWord;
   }
 
-  wiringPiSPIDataRW(channel, data, 34);
-}
+  // The scroll hint is only used when the columns that stayed on the screen
+  // are really the ones that were written last time.
+  uint16_t numberOfKeptColumns =
+      MATRIX_WIDTH - std::min<uint16_t>(std::abs(scrollHint), MATRIX_WIDTH);
+  bool isScrolled = state.isLastDataValid && (0 != scrollHint) &&
+                    (0 != numberOfKeptColumns);
+  if (isScrolled && (scrollHint > 0)) {
+    isScrolled = (0 == memcmp(columns, lastColumns + scrollHint,
+                              numberOfKeptColumns));
+  } else if (isScrolled) {
+    isScrolled = (0 == memcmp(columns - scrollHint, lastColumns,
+                              numberOfKeptColumns));
+  }
 
-uint16_t Sure3208LedMatrix::GetWidth() const {
-  if (m_isDouble) {
-    return (2 * MATRIX_WIDTH);
+  if (isScrolled) {
+    ht1632_encoder::EncodeScrolled(columns, scrollHint, lastData);
   } else {
-    return (MATRIX_WIDTH);
+    ht1632_encoder::Encode(columns, lastData);
   }
+  memcpy(lastColumns, columns, MATRIX_WIDTH);
+  state.isLastDataValid = true;
+
+  if ((1 == numberOfBursts) && (ht1632_encoder::NUMBER_OF_ADDRESSES ==
+                                bursts[0].numberOfNibbles)) {
+    transfers[0].channel = panel.channel;
+    transfers[0].data = lastData;
+    transfers[0].size = ht1632_encoder::FRAME_SIZE;
+  } else {
+    for (uint16_t i = 0; i < numberOfBursts; ++i) {
+      uint8_t *burstData = data + i * ht1632_encoder::FRAME_SIZE;
+      transfers[i].channel = panel.channel;
+      transfers[i].data = burstData;
+      transfers[i].size =
+          ht1632_encoder::EncodeBurst(columns, bursts[i], burstData);
+    }
+  }
+  return (numberOfBursts);
+}
+
+uint16_t Sure3208LedMatrix::GetWidth() const {
+  return (panel_layout::GetWidth(m_layout));
 }
 
-void Sure3208LedMatrix::SendCommand(unsigned char cmd) { SendCommand(0, cmd); }
+uint16_t Sure3208LedMatrix::GetHeight() const {
+  return (panel_layout::GetHeight(m_layout));
+}
 
-void Sure3208LedMatrix::SendCommand(int channel, unsigned char cmd) {
-  uint16_t data = 0;
-  data = COMMAND_HEADER;
-  data <<= 8;
-  data |= cmd;
-  data <<= 5;
-  ReverseEndian(&data, sizeof(data));
-  wiringPiSPIDataRW(channel, (unsigned char *)&data, 2);
+uint32_t Sure3208LedMatrix::GetFrameWriteTimeMicro() const {
+  // The panels share the clock of the bus, their frames are sent one after
+  // the other.
+  uint32_t speedHz = m_pSpiBus->GetSpeedHz();
+  if (0 == speedHz) {
+    return (0);
+  }
+  uint64_t bits = uint64_t(8) * ht1632_encoder::FRAME_SIZE * m_layout.size();
+  return (static_cast<uint32_t>(bits * 1000000 / speedHz));
 }
 
-void Sure3208LedMatrix::InitChannel(int channel) {
-  spdlog::info("Wiring Pi SPI setup for channel {}", channel);
-  if (wiringPiSPISetup(channel, (256 * 1024)) < 0) {
-    spdlog::error("SPI channel {} setup failed with error {} ", channel,
-                  strerror(errno));
-  }
-  spdlog::info("Wiring Pi SPI setup for channel {} done", channel);
-  SendCommand(channel, COMMAND_SYS_DYS);
-  SendCommand(channel, COMMAND_N_MOS_COM8);
-  SendCommand(channel, COMMAND_RC_MASTER_MODE);
-  SendCommand(channel, COMMAND_SYS_EN);
-  SendCommand(channel, COMMAND_LED_ON);
-  SendCommand(channel, COMMAND_BLINK_OFF);
+void Sure3208LedMatrix::SendCommand(unsigned char cmd) {
+  for (uint16_t i = 0; i < m_layout.size(); ++i) {
+    EncodeCommand(cmd, &m_commandData[i * COMMAND_SIZE]);
+    m_transfers[i].channel = m_layout[i].channel;
+    m_transfers[i].data = &m_commandData[i * COMMAND_SIZE];
+    m_transfers[i].size = COMMAND_SIZE;
+  }
+  m_pSpiBus->WriteBatch(m_transfers.data(), m_layout.size());
 }
 
-void Sure3208LedMatrix::Clear(int channel) {
-  unsigned char data[34];
-  memset(data, 0, sizeof(data));
-  data[0] = 0xa0;  // 0x10100000 101 is the command and 00000 are the first 5
-                   // bits of the address.
-  wiringPiSPIDataRW(channel, data, 34);
+void Sure3208LedMatrix::EncodeCommand(unsigned char cmd, uint8_t *data) {
+  // 3 bits of header, 8 bits of command and a last bit that does not matter.
+  uint16_t command = COMMAND_HEADER;
+  command <<= 8;
+  command |= cmd;
+  command <<= 5;
+  data[0] = static_cast<uint8_t>(command >> 8);
+  data[1] = static_cast<uint8_t>(command);
 }
 
-void *Sure3208LedMatrix::ReverseEndian(void *p, size_t size) {
-  char *head = reinterpret_cast<char *>(p);
-  char *tail = head + size - 1;
+bool Sure3208LedMatrix::Init() {
+  // Every panel has its own channel (see GetDrivenPanels()).
+  bool isSetup = true;
+  for (const Panel &panel : m_layout) {
+    if (!m_pSpiBus->Setup(panel.channel)) {
+      isSetup = false;
+    }
+  }
 
-  for (; tail > head; --tail, ++head) {
-    char temp = *head;
-    *head = *tail;
-    *tail = temp;
+  // The init sequences of all the screens are sent at once.
+  const unsigned char commands[] = {COMMAND_SYS_DYS,        COMMAND_N_MOS_COM8,
+                                    COMMAND_RC_MASTER_MODE, COMMAND_SYS_EN,
+                                    COMMAND_LED_ON,         COMMAND_BLINK_OFF};
+  const uint16_t numberOfCommands = sizeof(commands) / sizeof(commands[0]);
+  std::vector<uint8_t> data(m_layout.size() * numberOfCommands * COMMAND_SIZE);
+  std::vector<SpiTransfer> transfers(m_layout.size() * numberOfCommands);
+  uint16_t numberOfTransfers = 0;
+  for (const Panel &panel : m_layout) {
+    for (uint16_t i = 0; i < numberOfCommands; ++i) {
+      uint8_t *commandData = &data[numberOfTransfers * COMMAND_SIZE];
+      EncodeCommand(commands[i], commandData);
+      transfers[numberOfTransfers].channel = panel.channel;
+      transfers[numberOfTransfers].data = commandData;
+      transfers[numberOfTransfers].size = COMMAND_SIZE;
+      ++numberOfTransfers;
+    }
   }
-  return (p);
+  m_pSpiBus->WriteBatch(transfers.data(), numberOfTransfers);
+  return (isSetup);
 }
 
 }  // namespace ledmatrix
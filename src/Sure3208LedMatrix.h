@@ -16,22 +16,56 @@
 
 #include <stdint.h>
 #include <cstddef>
+#include <memory>
+#include <vector>
 #include "IGraphics.h"
+#include "src/Ht1632Encoder.h"
+#include "src/ILedMatrixDriver.h"
+#include "src/ISpiBus.h"
+#include "src/PanelLayout.h"
 
 namespace ledmatrix {
 /**
- * Manage one or two Sure 3208 led matrix(es) through SPI. This class rely on an
- * IGraphic object to print things on screen.
+ * Manage Sure 3208 led matrices through SPI. This class rely on an IGraphic
+ * object to print things on screen. Each matrix (panel) shows a 32x8 window
+ * of the graphics, see PanelLayout.
  */
-class Sure3208LedMatrix {
+class Sure3208LedMatrix : public ILedMatrixDriver {
  public:
   /**
-   * Constructor. Initialize the Led Matrix(s) and clear the screens.
+   * Constructor. Initialize the Led Matrix(s) through spidev and clear the
+   * screens.
    * @param isDouble must be true when two Sure 3208 Led Matrixes are connected
    * together.
    */
   explicit Sure3208LedMatrix(bool isDouble);
 
+  /**
+   * Constructor. Initialize the Led Matrix(s) and clear the screens.
+   * @param isDouble must be true when two Sure 3208 Led Matrixes are connected
+   * together.
+   * @param pSpiBus the bus the matrices are connected to.
+   */
+  Sure3208LedMatrix(bool isDouble, std::unique_ptr<ISpiBus> pSpiBus);
+
+  /**
+   * Constructor. Initialize the Led Matrices through spidev and clear the
+   * screens.
+   * @param layout the panels, with their channel and position.
+   */
+  explicit Sure3208LedMatrix(const PanelLayout& layout);
+
+  /**
+   * Constructor. Initialize the Led Matrices and clear the screens.
+   * @param layout the panels, with their channel and position. Every panel
+   * needs its own channel on the bus (see ISpiBus::GetNumberOfChannels()):
+   * otherwise the layout is refused, no panel is driven and IsInitialized()
+   * returns false.
+   * @param pSpiBus the bus the matrices are connected to.
+   */
+  Sure3208LedMatrix(const PanelLayout& layout,
+                    std::unique_ptr<ISpiBus> pSpiBus);
+
   /**
    * Destructor
    */
@@ -49,76 +83,150 @@ class Sure3208LedMatrix {
   /**
    * Clear the screen
    */
-  void Clear();
+  virtual void Clear();
 
   /**
    * Print the content of graphics on the screen. Will start at position (0,0).
    * The size of the graphics object does not really matter, everything outside
    * the boundaries will result in an OFF pixel.
+   * Each screen only receives the addresses whose pixels changed, and
+   * nothing if it already shows the content. When the graphics only scrolled
+   * (see IGraphics::GetScrollHint()), the previous commands are reused.
+   * When the bus drops the frame (see ISpiBus::TryWriteBatch()), the screens
+   * are entirely written next time.
+   * The caller is responsible for calling IGraphics::ClearDirtyColumns() once
+   * the graphics has been written, so that the next scroll hint is relative
+   * to this content.
    * @param graphics contains what will be printed.
    */
-  void WriteIGraphics(const IGraphics& graphics);
+  virtual void WriteIGraphics(const IGraphics& graphics);
+
+  /**
+   * @return true while some screens did not receive the last graphics
+   * written, because the bus dropped it.
+   */
+  virtual bool IsFrameDropped() const;
 
   /**
    * Set the brightness of the screen
    * @param level level of brightness. Range from 0 (least bright) to 16 (most
    * bright).
    */
-  void SetBrightness(unsigned char level);
+  virtual void SetBrightness(unsigned char level);
 
   /**
    * Toggle the pixels blinking
    * @param on if true, the blink command will be sent to the hardware.
    */
-  void Blink(bool on);
+  virtual void Blink(bool on);
 
   /**
    * Return the actual width of the physical screen
    */
-  uint16_t GetWidth() const;
+  virtual uint16_t GetWidth() const;
+
+  /**
+   * Return the actual height of the physical screen
+   */
+  virtual uint16_t GetHeight() const;
+
+  /**
+   * Return the time needed to send a whole HT1632 frame to every panel at the
+   * clock of the bus (see ISpiBus::GetSpeedHz()), in microseconds. 0 when the
+   * bus has no clock.
+   */
+  virtual uint32_t GetFrameWriteTimeMicro() const;
+
+  /**
+   * @return true if the whole layout is driven and every channel has been set
+   * up.
+   */
+  bool IsInitialized() const { return (m_isInitialized); }
+
+  /**
+   * Default clock frequency of the SPI bus. Too slow to show grayscale
+   * graphics (see Runtime).
+   */
+  static const uint32_t SPI_SPEED_HZ;
 
  private:
-  bool m_isDouble;
+  /**
+   * Panels actually connected to the bus. Initialized before m_pSpiBus.
+   */
+  PanelLayout m_layout;
+
+  std::unique_ptr<ISpiBus> m_pSpiBus;
+
+  /**
+   * Shadow copy of what a panel shows: the columns last written, and the
+   * command writing all of them. Used to send only the modified addresses,
+   * and to derive the next command when the content only scrolled.
+   */
+  struct PanelState {
+    uint8_t lastColumns[ht1632_encoder::NUMBER_OF_COLUMNS];
+    unsigned char lastData[ht1632_encoder::FRAME_SIZE];
+    bool isLastDataValid;
+    /**
+     * Number of messages of the panel in the last frame.
+     */
+    uint16_t numberOfTransfers;
+  };
+  std::vector<PanelState> m_panelStates;
 
   /**
-   * Send a command according to the HT1632 datasheet on channel 0.
+   * See IsInitialized().
+   */
+  bool m_isInitialized;
+
+  /**
+   * Messages of a frame, for all the panels (allocated once).
+   */
+  std::vector<uint8_t> m_data;
+  std::vector<SpiTransfer> m_transfers;
+  /**
+   * Messages of a command, for all the panels (allocated once).
+   */
+  std::vector<uint8_t> m_commandData;
+
+  /**
+   * Send a command according to the HT1632 datasheet to every panel at once.
    * @param cmd command to send.
    */
   void SendCommand(unsigned char cmd);
 
   /**
-   * Send a command according to the HT1632 datasheet.
-   * @param channel SPI channel (only 0 and 1 are supported).
+   * Build the message sending a command.
    * @param cmd command to send.
+   * @param data receives the COMMAND_SIZE bytes of the message.
    */
-  void SendCommand(int channel, unsigned char cmd);
+  static void EncodeCommand(unsigned char cmd, uint8_t* data);
 
   /**
-   * Print the content of graphics on the screen selected by channel (0 or 1).
-   * Will start at position (0,firstX).
-   * @param channel SPI channel (correspond to screen) on which to write.
-   * @param firstX start x position in graphics.
+   * Prepare the messages printing the content of graphics on a panel, and
+   * update its shadow copy.
+   * @param index index of the panel in the layout.
    * @param graphics contains what will be printed.
+   * @param scrollHint scroll hint of the graphics (0 if unknown).
+   * @param data storage for the bytes of the messages (MAX_NUMBER_OF_BURSTS
+   * times FRAME_SIZE bytes).
+   * @param transfers receives the messages to send.
+   * @return the number of messages, 0 if the panel already shows graphics.
    */
-  void WriteIGraphics(int channel, uint16_t firstX,
-                      const IGraphics& graphics);
+  uint16_t EncodeIGraphics(uint16_t index, const IGraphics& graphics,
+                           int16_t scrollHint, uint8_t* data,
+                           SpiTransfer* transfers);
 
   /**
-   * Send all the init commands needed on one channel (screen) in order to be
-   * ready to turn pixels ON or OFF.
-   * @param channel SPI channel (correspond to screen) on which to write.
+   * Set the channels up and send all the init commands needed on every
+   * panel in order to be ready to turn pixels ON or OFF.
+   * @return false if a channel could not be set up.
    */
-  void InitChannel(int channel);
+  bool Init();
 
-  /**
-   * Clear the screen identified by channel.
-   * @param channel screen to clear.
-   */
-  void Clear(int channel);
+  static const unsigned char MATRIX_WIDTH = 32;
 
-  void* ReverseEndian(void* p, size_t size);
 
-  static const unsigned char MATRIX_WIDTH = 32;
+  static const uint16_t COMMAND_SIZE = 2;  // Size of a command message
 
   static const unsigned char COMMAND_HEADER =
       0x4;  // Header, every command starts with 101
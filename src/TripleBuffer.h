@@ -0,0 +1,108 @@
+/**
+ * @file TripleBuffer.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Lock free exchange of frames between two threads
+ * @version 0.1
+ * @date 2019-06-11
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+
+namespace ledmatrix {
+
+/**
+ * Hand over complete frames of type \a T from one producer thread to one
+ * consumer thread, without any lock and without copying.
+ *
+ * The producer draws in the back buffer and publishes it. The consumer takes
+ * the latest published frame as front buffer: frames published in between are
+ * simply skipped and no buffer is ever used by both threads at the same time.
+ * The third buffer (the middle one) holds the last published frame and is
+ * exchanged atomically with the back or the front buffer.
+ */
+template <typename T>
+class TripleBuffer {
+ public:
+  TripleBuffer() : m_back(0), m_middle(1), m_front(2) {}
+  virtual ~TripleBuffer() {}
+
+  // Prevent wrong usage of these operators.
+  TripleBuffer(const TripleBuffer& other) = delete;
+  TripleBuffer& operator=(const TripleBuffer& other) = delete;
+  TripleBuffer(TripleBuffer&& other) = delete;
+  TripleBuffer& operator=(TripleBuffer&& other) = delete;
+  bool operator==(const TripleBuffer& other) const = delete;
+  bool operator!=(const TripleBuffer& other) const = delete;
+
+  /**
+   * Producer side. The buffer keeps its content after a call to Publish():
+   * it is then one of the previously published frames.
+   * @return the buffer to draw the next frame in.
+   */
+  T& GetBackBuffer() { return (m_buffers[m_back]); }
+
+  /**
+   * Producer side. Make the back buffer available to the consumer.
+   */
+  void Publish() {
+    uint8_t previous =
+        m_middle.exchange(m_back | NEW_FRAME, std::memory_order_acq_rel);
+    m_back = previous & INDEX_MASK;
+  }
+
+  /**
+   * Consumer side. Take the latest published frame as front buffer, if any.
+   * @return true if a new frame is available in the front buffer.
+   */
+  bool Consume() {
+    if (0 == (m_middle.load(std::memory_order_relaxed) & NEW_FRAME)) {
+      return (false);
+    }
+    uint8_t previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+    m_front = previous & INDEX_MASK;
+    return (true);
+  }
+
+  /**
+   * Consumer side.
+   * @return the last consumed frame.
+   */
+  const T& GetFrontBuffer() const { return (m_buffers[m_front]); }
+
+ private:
+  static const uint8_t INDEX_MASK = 0x03;
+  static const uint8_t NEW_FRAME = 0x04;
+
+  std::array<T, 3> m_buffers;
+  /**
+   * Only used by the producer thread.
+   */
+  uint8_t m_back;
+  /**
+   * Index of the middle buffer, with the NEW_FRAME flag when it has been
+   * published but not consumed yet.
+   */
+  std::atomic<uint8_t> m_middle;
+  /**
+   * Only used by the consumer thread.
+   */
+  uint8_t m_front;
+};
+
+template <typename T>
+const uint8_t TripleBuffer<T>::INDEX_MASK;
+template <typename T>
+const uint8_t TripleBuffer<T>::NEW_FRAME;
+
+}  // namespace ledmatrix
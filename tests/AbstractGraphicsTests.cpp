@@ -0,0 +1,170 @@
+/**
+ * @file AbstractGraphicsTests.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Unit tests for the AbstractGraphics class
+ * @version 0.1
+ * @date 2019-06-10
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#include <gtest/gtest.h>
+
+#include "src/FixedGraphics.h"
+#include "src/MonoColor8RowsGraphics.h"
+
+TEST(AbstractGraphics, Generation) {
+  ledmatrix::MonoColor8RowsGraphics graphics;
+  const uint8_t columns[] = {0x01, 0x02};
+
+  // 0 is reserved for the untracked graphics.
+  uint32_t generation = graphics.GetGeneration();
+  EXPECT_NE(generation, 0u);
+
+  // Reading does not modify anything
+  EXPECT_EQ(graphics.GetPixel(0, 0), false);
+  graphics.GetContentHash();
+  graphics.ClearDirtyColumns();
+  EXPECT_EQ(graphics.GetGeneration(), generation);
+
+  graphics.SetPixel(0, 0, true);
+  EXPECT_GT(graphics.GetGeneration(), generation);
+  generation = graphics.GetGeneration();
+
+  graphics.WriteColumns(1, 0, columns, sizeof(columns));
+  EXPECT_GT(graphics.GetGeneration(), generation);
+  generation = graphics.GetGeneration();
+
+  graphics.Shift(ledmatrix::Left, 1);
+  EXPECT_GT(graphics.GetGeneration(), generation);
+  generation = graphics.GetGeneration();
+
+  graphics.Reset();
+  EXPECT_GT(graphics.GetGeneration(), generation);
+}
+
+TEST(AbstractGraphics, ContentHash) {
+  ledmatrix::MonoColor8RowsGraphics graphics;
+  const uint8_t columns[] = {0x3e, 0x41, 0x41, 0x3e};
+
+  graphics.SetWidth(32);
+  uint64_t blankHash = graphics.GetContentHash();
+
+  graphics.WriteColumns(10, 0, columns, sizeof(columns));
+  uint64_t hash = graphics.GetContentHash();
+  EXPECT_NE(hash, blankHash);
+
+  // Drawing the same content again gives the same hash
+  graphics.Reset();
+  graphics.SetWidth(32);
+  EXPECT_EQ(graphics.GetContentHash(), blankHash);
+  graphics.WriteColumns(10, 0, columns, sizeof(columns));
+  EXPECT_EQ(graphics.GetContentHash(), hash);
+
+  // A single pixel or the same content at another position is different
+  graphics.SetPixel(31, 7, true);
+  EXPECT_NE(graphics.GetContentHash(), hash);
+  graphics.SetPixel(31, 7, false);
+  EXPECT_EQ(graphics.GetContentHash(), hash);
+  graphics.Rotate(ledmatrix::Right, 1);
+  EXPECT_NE(graphics.GetContentHash(), hash);
+  graphics.Rotate(ledmatrix::Left, 1);
+  EXPECT_EQ(graphics.GetContentHash(), hash);
+}
+
+TEST(AbstractGraphics, ContentHashTallGraphics) {
+  typedef ledmatrix::FixedGraphics<32, 16> Graphics;
+  Graphics graphics;
+  uint64_t blankHash = graphics.GetContentHash();
+
+  // The rows after the first 8 ones are part of the hash
+  graphics.SetPixel(3, 12, true);
+  uint64_t hash = graphics.GetContentHash();
+  EXPECT_NE(hash, blankHash);
+  graphics.SetPixel(3, 12, false);
+  EXPECT_EQ(graphics.GetContentHash(), blankHash);
+  graphics.SetPixel(3, 13, true);
+  EXPECT_NE(graphics.GetContentHash(), hash);
+}
+
+TEST(AbstractGraphics, DirtyColumns) {
+  ledmatrix::MonoColor8RowsGraphics graphics;
+  graphics.SetWidth(32);
+  const uint8_t columns[] = {0x01, 0x02, 0x04};
+
+  // A new object has never been written anywhere.
+  EXPECT_TRUE(graphics.GetDirtyColumns().Intersects(0, 32));
+
+  graphics.ClearDirtyColumns();
+  EXPECT_TRUE(graphics.GetDirtyColumns().IsEmpty());
+
+  graphics.SetPixel(5, 3, true);
+  EXPECT_EQ(graphics.GetDirtyColumns().first, 5);
+  EXPECT_EQ(graphics.GetDirtyColumns().end, 6);
+  EXPECT_FALSE(graphics.GetDirtyColumns().Intersects(0, 5));
+  EXPECT_TRUE(graphics.GetDirtyColumns().Intersects(0, 6));
+
+  graphics.WriteColumns(10, 0, columns, sizeof(columns));
+  EXPECT_EQ(graphics.GetDirtyColumns().first, 5);
+  EXPECT_EQ(graphics.GetDirtyColumns().end, 13);
+
+  graphics.ClearDirtyColumns();
+  graphics.FillColumns(1, 0, 2, 0xff);
+  EXPECT_EQ(graphics.GetDirtyColumns().first, 1);
+  EXPECT_EQ(graphics.GetDirtyColumns().end, 3);
+
+  // Reading does not modify anything
+  graphics.ClearDirtyColumns();
+  uint8_t result[4];
+  graphics.ReadColumns(0, 0, result, sizeof(result));
+  EXPECT_EQ(graphics.GetPixel(1, 0), true);
+  EXPECT_TRUE(graphics.GetDirtyColumns().IsEmpty());
+
+  // Every column moves
+  graphics.Shift(ledmatrix::Left, 1);
+  EXPECT_TRUE(graphics.GetDirtyColumns().Intersects(0, 1));
+  EXPECT_TRUE(graphics.GetDirtyColumns().Intersects(31, 1));
+
+  graphics.ClearDirtyColumns();
+  graphics.Reset();
+  EXPECT_TRUE(graphics.GetDirtyColumns().Intersects(0, 32));
+}
+
+TEST(AbstractGraphics, ScrollHint) {
+  ledmatrix::MonoColor8RowsGraphics graphics;
+  graphics.SetWidth(32);
+
+  // Nothing is known about a new object.
+  EXPECT_EQ(graphics.GetScrollHint(), 0);
+
+  graphics.ClearDirtyColumns();
+  graphics.Shift(ledmatrix::Left, 1);
+  EXPECT_EQ(graphics.GetScrollHint(), 1);
+  graphics.Shift(ledmatrix::Left, 2);
+  EXPECT_EQ(graphics.GetScrollHint(), 3);
+  graphics.Shift(ledmatrix::Right, 1);
+  EXPECT_EQ(graphics.GetScrollHint(), 2);
+
+  // Any other modification makes the hint unknown.
+  graphics.SetPixel(3, 3, true);
+  EXPECT_EQ(graphics.GetScrollHint(), 0);
+  graphics.Shift(ledmatrix::Left, 1);
+  EXPECT_EQ(graphics.GetScrollHint(), 0);
+
+  graphics.ClearDirtyColumns();
+  graphics.Shift(ledmatrix::Right, 2);
+  EXPECT_EQ(graphics.GetScrollHint(), -2);
+  graphics.Reset();
+  EXPECT_EQ(graphics.GetScrollHint(), 0);
+
+  // Copies take over the hint.
+  graphics.ClearDirtyColumns();
+  graphics.Shift(ledmatrix::Left, 4);
+  ledmatrix::FixedGraphics<32, 8> copy;
+  copy.CopyFrom(graphics);
+  EXPECT_EQ(copy.GetScrollHint(), 4);
+}
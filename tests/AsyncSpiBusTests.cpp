@@ -0,0 +1,144 @@
+/**
+ * @file AsyncSpiBusTests.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Unit tests for the asynchronous SPI transport
+ * @version 0.1
+ * @date 2019-06-14
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "mocks/MockISpiBus.h"
+#include "src/AsyncSpiBus.h"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace {
+
+/**
+ * Mock bus recording the first byte and the channel of each message. It
+ * waits for \a pIsOpen to be true before sending anything.
+ */
+std::unique_ptr<ledmatrix::ISpiBus> CreateRecordingBus(
+    std::vector<int>* pChannels, std::vector<uint8_t>* pMessages,
+    std::atomic<bool>* pIsOpen) {
+  std::unique_ptr<NiceMock<ledmatrix::MockISpiBus>> pBus(
+      new NiceMock<ledmatrix::MockISpiBus>());
+  ON_CALL(*pBus, Setup(_)).WillByDefault(Return(true));
+  ON_CALL(*pBus, WriteBatch(_, _))
+      .WillByDefault(Invoke([=](const ledmatrix::SpiTransfer* transfers,
+                                uint16_t count) {
+        while (!pIsOpen->load()) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        for (uint16_t i = 0; i < count; ++i) {
+          pChannels->push_back(transfers[i].channel);
+          pMessages->push_back(transfers[i].data[0]);
+        }
+        return (true);
+      }));
+  return (pBus);
+}
+
+}  // namespace
+
+TEST(AsyncSpiBus, MessagesAreSentInOrder) {
+  std::vector<int> channels;
+  std::vector<uint8_t> messages;
+  std::atomic<bool> isOpen(true);
+  std::vector<uint8_t> bytes(2 *
+                             ledmatrix::AsyncSpiBus::MAX_TRANSFERS_PER_SLOT);
+  {
+    ledmatrix::AsyncSpiBus bus(
+        CreateRecordingBus(&channels, &messages, &isOpen));
+    EXPECT_TRUE(bus.Setup(0));
+
+    // The bytes are copied: the caller can reuse its buffers right away.
+    uint8_t data[3] = {1, 2, 3};
+    ledmatrix::SpiTransfer transfers[3] = {
+        {0, &data[0], 1}, {1, &data[1], 1}, {0, &data[2], 1}};
+    EXPECT_TRUE(bus.WriteBatch(transfers, 3));
+    data[0] = 4;
+    EXPECT_TRUE(bus.Write(1, &data[0], 1));
+    bus.Flush();
+    EXPECT_EQ(messages, std::vector<uint8_t>({1, 2, 3, 4}));
+    EXPECT_EQ(channels, std::vector<int>({0, 1, 0, 1}));
+
+    // Batches larger than a slot are split.
+    std::vector<ledmatrix::SpiTransfer> manyTransfers;
+    for (uint16_t i = 0; i < bytes.size(); ++i) {
+      bytes[i] = static_cast<uint8_t>(i);
+      manyTransfers.push_back({0, &bytes[i], 1});
+    }
+    messages.clear();
+    EXPECT_TRUE(bus.WriteBatch(manyTransfers.data(), manyTransfers.size()));
+    data[0] = 5;
+    // The destructor sends what is still queued.
+    EXPECT_TRUE(bus.Write(0, &data[0], 1));
+  }
+  ASSERT_EQ(messages.size(), bytes.size() + 1);
+  for (uint16_t i = 0; i < bytes.size(); ++i) {
+    EXPECT_EQ(messages[i], bytes[i]);
+  }
+  EXPECT_EQ(messages.back(), 5);
+}
+
+TEST(AsyncSpiBus, FramesAreDroppedWhenTheBusIsBusy) {
+  std::vector<int> channels;
+  std::vector<uint8_t> messages;
+  std::atomic<bool> isOpen(false);
+  ledmatrix::AsyncSpiBus bus(CreateRecordingBus(&channels, &messages, &isOpen));
+
+  // The bus is stuck while sending the first frame: a second one waits
+  // behind it, the next ones are dropped.
+  uint8_t frame = 0;
+  ledmatrix::SpiTransfer transfer = {0, &frame, 1};
+  for (uint16_t i = 0; i < 10; ++i) {
+    ++frame;
+    EXPECT_EQ(bus.TryWriteBatch(&transfer, 1), frame <= 2);
+  }
+  EXPECT_EQ(bus.GetNumberOfDroppedBatches(), 8u);
+
+  // Only those two frames are sent once the bus is available again: the
+  // latest frame written next is at most one frame behind.
+  isOpen = true;
+  bus.Flush();
+  EXPECT_EQ(messages, std::vector<uint8_t>({1, 2}));
+  EXPECT_TRUE(bus.TryWriteBatch(&transfer, 1));
+  bus.Flush();
+  EXPECT_EQ(messages, std::vector<uint8_t>({1, 2, 10}));
+}
+
+TEST(AsyncSpiBus, CommandsUseTheWholeQueue) {
+  std::vector<int> channels;
+  std::vector<uint8_t> messages;
+  std::atomic<bool> isOpen(false);
+  ledmatrix::AsyncSpiBus bus(CreateRecordingBus(&channels, &messages, &isOpen));
+
+  // The commands are queued behind each other, a frame is dropped then.
+  uint8_t command = 1;
+  ledmatrix::SpiTransfer transfer = {0, &command, 1};
+  for (uint16_t i = 0; i < ledmatrix::AsyncSpiBus::NUMBER_OF_SLOTS; ++i) {
+    EXPECT_TRUE(bus.WriteBatch(&transfer, 1));
+  }
+  EXPECT_FALSE(bus.TryWriteBatch(&transfer, 1));
+  isOpen = true;
+  bus.Flush();
+  EXPECT_EQ(messages.size(), ledmatrix::AsyncSpiBus::NUMBER_OF_SLOTS);
+}
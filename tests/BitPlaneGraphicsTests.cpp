@@ -0,0 +1,263 @@
+/**
+ * @file BitPlaneGraphicsTests.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Test for the BitPlaneGraphics class
+ * @version 0.1
+ * @date 2019-06-07
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+#include <random>
+
+#include "src/BitPlaneGraphics.h"
+#include "src/MonoColor8RowsGraphics.h"
+
+namespace {
+
+/**
+ * Check that both matrices have the same size and the same pixels.
+ */
+static void ExpectSameGraphics(const ledmatrix::IGraphics& expected,
+                               const ledmatrix::IGraphics& actual) {
+  ASSERT_EQ(actual.GetWidth(), expected.GetWidth());
+  for (uint16_t x = 0; x < expected.GetWidth(); ++x) {
+    for (uint16_t y = 0; y < expected.GetHeight(); ++y) {
+      ASSERT_EQ(actual.GetPixel(x, y), expected.GetPixel(x, y))
+          << "at (" << x << ", " << y << ")";
+    }
+  }
+}
+
+}  // namespace
+
+TEST(BitPlaneGraphics, GetSetPixel) {
+  ledmatrix::BitPlaneGraphics graphics;
+  EXPECT_EQ(graphics.GetWidth(), 0);
+  EXPECT_EQ(graphics.GetHeight(), BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS);
+
+  graphics.SetPixel(0, 0, true);
+  graphics.SetPixel(0, 7, true);
+  EXPECT_EQ(graphics.GetPixel(0, 0), true);
+  EXPECT_EQ(graphics.GetPixel(0, 3), false);
+  EXPECT_EQ(graphics.GetPixel(0, 7), true);
+  graphics.SetPixel(0, 0, false);
+  EXPECT_EQ(graphics.GetPixel(0, 0), false);
+
+  // Set pixel in the second word of the rows
+  graphics.SetPixel(70, 4, true);
+  EXPECT_EQ(graphics.GetWidth(), 71);
+  EXPECT_EQ(graphics.GetPixel(70, 4), true);
+  EXPECT_EQ(graphics.GetPixel(69, 4), false);
+
+  // Outside of the bounds
+  graphics.SetPixel(2, 8, true);
+  EXPECT_EQ(graphics.GetPixel(2, 8), false);
+  EXPECT_EQ(graphics.GetPixel(100, 4), false);
+  EXPECT_EQ(graphics.GetWidth(), 71);
+
+  graphics.Reset();
+  EXPECT_EQ(graphics.GetWidth(), 71);
+  EXPECT_EQ(graphics.GetPixel(70, 4), false);
+  graphics.Clear();
+  EXPECT_EQ(graphics.GetWidth(), 0);
+}
+
+TEST(BitPlaneGraphics, Columns) {
+  ledmatrix::BitPlaneGraphics graphics;
+  uint8_t columns[20];
+  uint8_t result[24];
+  for (uint8_t i = 0; i < sizeof(columns); ++i) {
+    columns[i] = static_cast<uint8_t>(0x11 * i + 1);
+  }
+
+  // Write across the first word boundary
+  graphics.WriteColumns(56, 0, columns, sizeof(columns));
+  EXPECT_EQ(graphics.GetWidth(), 76);
+  for (uint16_t i = 0; i < sizeof(columns); ++i) {
+    for (uint16_t y = 0; y < BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS; ++y) {
+      EXPECT_EQ(graphics.GetPixel(56 + i, y), 0 != (columns[i] & (0x1 << y)));
+    }
+  }
+
+  // Columns outside of the boundaries are read as blank
+  memset(result, 0xff, sizeof(result));
+  graphics.ReadColumns(54, 0, result, sizeof(result));
+  EXPECT_EQ(result[0], 0x00);
+  EXPECT_EQ(result[1], 0x00);
+  EXPECT_EQ(memcmp(result + 2, columns, sizeof(columns)), 0);
+  EXPECT_EQ(result[22], 0x00);
+  EXPECT_EQ(result[23], 0x00);
+
+  // Columns with an offset only touch the rows from y
+  graphics.WriteColumns(0, 4, columns + 1, 2);
+  EXPECT_EQ(graphics.GetPixel(0, 5), true);
+  EXPECT_EQ(graphics.GetPixel(0, 4), false);
+  graphics.ReadColumns(0, 4, result, 2);
+  EXPECT_EQ(result[0], columns[1] & 0x0F);
+  EXPECT_EQ(result[1], columns[2] & 0x0F);
+
+  // Fill a range over the word boundary, only the rows from 4 are changed
+  graphics.FillColumns(60, 4, 10, 0x05);
+  graphics.ReadColumns(60, 0, result, 10);
+  for (uint16_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(result[i], (columns[i + 4] & 0x0F) | 0x50);
+  }
+}
+
+TEST(BitPlaneGraphics, Rotate) {
+  ledmatrix::BitPlaneGraphics graphics;
+
+  graphics.Rotate(ledmatrix::Left, 2);
+  EXPECT_EQ(graphics.GetWidth(), 0);
+
+  graphics.SetPixel(0, 0, true);
+  graphics.SetPixel(1, 1, true);
+  graphics.SetPixel(2, 2, true);
+  graphics.SetPixel(3, 3, true);
+
+  graphics.Rotate(ledmatrix::Left, 1);
+  EXPECT_EQ(graphics.GetPixel(0, 1), true);
+  EXPECT_EQ(graphics.GetPixel(3, 0), true);
+
+  graphics.Rotate(ledmatrix::Right, 5);
+  EXPECT_EQ(graphics.GetPixel(0, 0), true);
+  EXPECT_EQ(graphics.GetPixel(3, 3), true);
+
+  graphics.Rotate(ledmatrix::Up, 1);
+  EXPECT_EQ(graphics.GetPixel(0, 1), true);
+  EXPECT_EQ(graphics.GetPixel(3, 4), true);
+
+  graphics.Rotate(ledmatrix::Down, 2);
+  EXPECT_EQ(graphics.GetPixel(1, 0), true);
+  EXPECT_EQ(graphics.GetPixel(0, 0), false);
+
+  graphics.Rotate(ledmatrix::Up, 8);
+  EXPECT_EQ(graphics.GetPixel(3, 2), false);
+}
+
+TEST(BitPlaneGraphics, Shift) {
+  ledmatrix::BitPlaneGraphics graphics;
+
+  graphics.Shift(ledmatrix::Left, 2);
+  EXPECT_EQ(graphics.GetWidth(), 0);
+
+  for (uint16_t i = 0; i < 6; ++i) {
+    graphics.SetPixel(i, i, true);
+  }
+  EXPECT_EQ(graphics.GetWidth(), 6);
+
+  graphics.Shift(ledmatrix::Left, 1);
+  EXPECT_EQ(graphics.GetWidth(), 5);
+  EXPECT_EQ(graphics.GetPixel(0, 1), true);
+  EXPECT_EQ(graphics.GetPixel(4, 5), true);
+
+  // The column shifted out comes back before the blank one
+  graphics.Shift(ledmatrix::Right, 2);
+  EXPECT_EQ(graphics.GetWidth(), 7);
+  EXPECT_EQ(graphics.GetPixel(0, 0), false);
+  EXPECT_EQ(graphics.GetPixel(1, 0), true);
+  EXPECT_EQ(graphics.GetPixel(2, 1), true);
+
+  // Shift over more than a word
+  graphics.Shift(ledmatrix::Right, 100);
+  EXPECT_EQ(graphics.GetWidth(), 107);
+  EXPECT_EQ(graphics.GetPixel(101, 0), true);
+  EXPECT_EQ(graphics.GetPixel(106, 5), true);
+
+  graphics.Shift(ledmatrix::Left, 200);
+  EXPECT_EQ(graphics.GetWidth(), 0);
+}
+
+TEST(BitPlaneGraphics, SameAsMonoColor8RowsGraphics) {
+  ledmatrix::BitPlaneGraphics graphics;
+  ledmatrix::MonoColor8RowsGraphics reference;
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<uint16_t> position(0, 150);
+  std::uniform_int_distribution<uint16_t> operation(0, 6);
+
+  for (uint16_t i = 0; i < 2000; ++i) {
+    uint16_t x = position(generator);
+    uint16_t value = position(generator);
+    uint8_t columns[8];
+    for (uint8_t& column : columns) {
+      column = static_cast<uint8_t>(generator());
+    }
+    switch (operation(generator)) {
+      case 0:
+        graphics.SetPixel(x, value % 8, true);
+        reference.SetPixel(x, value % 8, true);
+        break;
+      case 1:
+        graphics.WriteColumns(x, value % 8, columns, value % 8 + 1);
+        reference.WriteColumns(x, value % 8, columns, value % 8 + 1);
+        break;
+      case 2:
+        graphics.FillColumns(x, value % 8, value % 70, columns[0]);
+        reference.FillColumns(x, value % 8, value % 70, columns[0]);
+        break;
+      case 3:
+        if (0 != reference.GetWidth()) {
+          graphics.Shift(ledmatrix::Left, value % 10);
+          reference.Shift(ledmatrix::Left, value % 10);
+        }
+        break;
+      case 4:
+        if (0 != reference.GetWidth()) {
+          graphics.Shift(ledmatrix::Right, value % 70);
+          reference.Shift(ledmatrix::Right, value % 70);
+        }
+        break;
+      case 5:
+        graphics.Rotate(0 == (x % 2) ? ledmatrix::Left : ledmatrix::Right,
+                        value);
+        reference.Rotate(0 == (x % 2) ? ledmatrix::Left : ledmatrix::Right,
+                         value);
+        break;
+      default:
+        graphics.Rotate(0 == (x % 2) ? ledmatrix::Up : ledmatrix::Down,
+                        value % 3);
+        reference.Rotate(0 == (x % 2) ? ledmatrix::Up : ledmatrix::Down,
+                         value % 3);
+        break;
+    }
+    if (reference.GetWidth() > 300) {
+      graphics.Clear();
+      reference.Clear();
+    }
+    ExpectSameGraphics(reference, graphics);
+    if (HasFatalFailure()) {
+      return;
+    }
+  }
+}
+
+TEST(BitPlaneGraphics, EndlessScrolling) {
+  ledmatrix::BitPlaneGraphics graphics;
+  const uint16_t screenSize = 32;
+  const uint32_t numberOfSteps = 100000;
+
+  graphics.SetWidth(screenSize);
+  for (uint32_t i = 0; i < numberOfSteps; ++i) {
+    graphics.Shift(ledmatrix::Left, 1);
+    graphics.SetPixel(screenSize - 1, i % BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS,
+                      true);
+    ASSERT_EQ(graphics.GetWidth(), screenSize);
+  }
+
+  for (uint16_t x = 0; x < screenSize; ++x) {
+    uint32_t i = numberOfSteps - screenSize + x;
+    for (uint16_t y = 0; y < BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS; ++y) {
+      EXPECT_EQ(graphics.GetPixel(x, y),
+                (i % BIT_PLANE_GRAPHICS_NUMBER_OF_ROWS) == y);
+    }
+  }
+}
@@ -0,0 +1,89 @@
+/**
+ * @file BitPlaneModulatorTests.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Unit tests for the bit plane modulation
+ * @version 0.1
+ * @date 2019-06-18
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "mocks/MockILedMatrixDriver.h"
+#include "src/BitPlaneModulator.h"
+#include "src/GrayscaleGraphics.h"
+#include "src/RecordingSpiBus.h"
+#include "src/Sure3208LedMatrix.h"
+
+using ::testing::InSequence;
+using ::testing::Ref;
+using ::testing::StrictMock;
+
+TEST(BitPlaneModulator, Duties) {
+  // The weights of the planes are powers of two at full brightness.
+  EXPECT_EQ(ledmatrix::bit_plane_modulator::GetDuty(3, 15), 15);
+  EXPECT_EQ(ledmatrix::bit_plane_modulator::GetDuty(2, 15), 7);
+  EXPECT_EQ(ledmatrix::bit_plane_modulator::GetDuty(1, 15), 3);
+  EXPECT_EQ(ledmatrix::bit_plane_modulator::GetDuty(0, 15), 1);
+
+  EXPECT_EQ(ledmatrix::bit_plane_modulator::GetDuty(3, 7), 7);
+  EXPECT_EQ(ledmatrix::bit_plane_modulator::GetDuty(0, 7), 0);
+  EXPECT_EQ(ledmatrix::bit_plane_modulator::GetDuty(3, 0), 0);
+  EXPECT_EQ(ledmatrix::bit_plane_modulator::GetDuty(2, 0), 0);
+}
+
+TEST(BitPlaneModulator, SubFrames) {
+  StrictMock<ledmatrix::MockILedMatrixDriver> hardware;
+  ledmatrix::GrayscaleGraphics<32, 8> graphics;
+
+  // Every duty then its plane, the most significant one last.
+  {
+    InSequence sequence;
+    for (uint8_t p = 0; p < 4; ++p) {
+      uint8_t duty = ledmatrix::bit_plane_modulator::GetDuty(p, 15);
+      EXPECT_CALL(hardware, SetBrightness(duty));
+      EXPECT_CALL(hardware, WriteIGraphics(Ref(graphics.GetBitPlane(p))));
+    }
+  }
+  for (uint8_t i = 0;
+       i < ledmatrix::bit_plane_modulator::NUMBER_OF_SUB_FRAMES; ++i) {
+    ledmatrix::bit_plane_modulator::WriteSubFrame(hardware, graphics, i, 15);
+  }
+}
+
+TEST(BitPlaneModulator, OnlyTheModifiedAddressesAreSent) {
+  std::unique_ptr<ledmatrix::RecordingSpiBus> pBus(
+      new ledmatrix::RecordingSpiBus());
+  ledmatrix::RecordingSpiBus* pRawBus = pBus.get();
+  ledmatrix::Sure3208LedMatrix matrix(false, std::move(pBus));
+
+  // Planes 1 and 3 only differ on the first column.
+  ledmatrix::GrayscaleGraphics<32, 8> graphics;
+  graphics.SetLevel(0, 0, 2);
+  for (uint16_t x = 1; x < 32; ++x) {
+    graphics.SetLevel(x, 0, 10);
+  }
+  ledmatrix::bit_plane_modulator::WriteSubFrame(matrix, graphics, 1, 15);
+  pRawBus->ClearTransfers();
+  ledmatrix::bit_plane_modulator::WriteSubFrame(matrix, graphics, 3, 15);
+
+  // The brightness command, then a short burst.
+  std::vector<ledmatrix::RecordedSpiTransfer> transfers =
+      pRawBus->GetTransfers();
+  ASSERT_EQ(transfers.size(), 2u);
+  EXPECT_EQ(transfers[0].data.size(), 2u);
+  EXPECT_LT(transfers[1].data.size(), ledmatrix::ht1632_encoder::FRAME_SIZE);
+
+  uint8_t columns[ledmatrix::ht1632_encoder::NUMBER_OF_COLUMNS];
+  pRawBus->GetColumns(0, columns);
+  EXPECT_EQ(columns[0], 0x00);
+  EXPECT_EQ(columns[1], 0x01);
+}
@@ -0,0 +1,99 @@
+/**
+ * @file DisplayEffectsTests.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Unit tests for the hardware effects
+ * @version 0.1
+ * @date 2019-06-17
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "mocks/MockILedMatrixDriver.h"
+#include "src/DisplayEffects.h"
+
+using ::testing::_;
+using ::testing::InSequence;
+using ::testing::StrictMock;
+
+TEST(DisplayEffects, CommandsAreOnlySentOnChange) {
+  StrictMock<ledmatrix::MockILedMatrixDriver> hardware;
+  ledmatrix::DisplayEffects effects;
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+  EXPECT_CALL(hardware, SetBrightness(15)).Times(1);
+  effects.Apply(hardware, now);
+  effects.Apply(hardware, now);
+  ::testing::Mock::VerifyAndClearExpectations(&hardware);
+
+  EXPECT_CALL(hardware, SetBrightness(4)).Times(1);
+  EXPECT_CALL(hardware, Blink(true)).Times(1);
+  effects.SetBrightness(4);
+  effects.Blink(true);
+  effects.Apply(hardware, now);
+  effects.Apply(hardware, now);
+  ::testing::Mock::VerifyAndClearExpectations(&hardware);
+
+  EXPECT_CALL(hardware, Blink(false)).Times(1);
+  effects.Blink(false);
+  effects.Apply(hardware, now);
+  EXPECT_EQ(effects.GetBrightness(), 4);
+
+  // Out of range levels are clamped.
+  EXPECT_CALL(hardware, SetBrightness(15)).Times(1);
+  effects.SetBrightness(200);
+  effects.Apply(hardware, now);
+}
+
+TEST(DisplayEffects, Ramps) {
+  StrictMock<ledmatrix::MockILedMatrixDriver> hardware;
+  ledmatrix::DisplayEffects effects;
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  EXPECT_CALL(hardware, SetBrightness(15)).Times(1);
+  effects.Apply(hardware, now);
+  ::testing::Mock::VerifyAndClearExpectations(&hardware);
+
+  // One command per level, whatever the number of display cycles.
+  {
+    InSequence sequence;
+    for (int level = 14; level >= 0; --level) {
+      EXPECT_CALL(hardware, SetBrightness(level)).Times(1);
+    }
+  }
+  effects.FadeTo(0, 150, now);
+  EXPECT_EQ(effects.GetBrightness(), 0);
+  for (int milli = 0; milli <= 200; milli += 5) {
+    effects.Apply(hardware, now + std::chrono::milliseconds(milli));
+  }
+  ::testing::Mock::VerifyAndClearExpectations(&hardware);
+
+  // A fade in goes back to the brightness that was set, from the least
+  // bright level (already on the screen).
+  effects.SetBrightness(8);
+  now += std::chrono::milliseconds(200);
+  effects.FadeIn(80, now);
+  {
+    InSequence sequence;
+    for (int level = 1; level <= 8; ++level) {
+      EXPECT_CALL(hardware, SetBrightness(level)).Times(1);
+    }
+  }
+  for (int milli = 0; milli <= 100; milli += 5) {
+    effects.Apply(hardware, now + std::chrono::milliseconds(milli));
+  }
+  ::testing::Mock::VerifyAndClearExpectations(&hardware);
+
+  // A ramp started in the middle of another one starts where it is.
+  effects.FadeTo(0, 80, now + std::chrono::milliseconds(100));
+  EXPECT_CALL(hardware, SetBrightness(4)).Times(1);
+  effects.FadeTo(15, 80, now + std::chrono::milliseconds(140));
+  effects.Apply(hardware, now + std::chrono::milliseconds(140));
+}
@@ -0,0 +1,55 @@
+/**
+ * @file FileSpiBusTests.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Unit tests for the file SPI transport
+ * @version 0.1
+ * @date 2019-06-15
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "src/FileSpiBus.h"
+
+TEST(FileSpiBus, Write) {
+  std::string path = ::testing::TempDir() + "FileSpiBusTests.txt";
+  {
+    ledmatrix::FileSpiBus bus(path);
+    EXPECT_TRUE(bus.Setup(0));
+
+    uint8_t data[3] = {0xa0, 0x0f, 0x42};
+    ledmatrix::SpiTransfer transfers[2] = {{0, &data[0], 2}, {1, &data[2], 1}};
+    EXPECT_TRUE(bus.WriteBatch(transfers, 2));
+    EXPECT_TRUE(bus.Write(1, &data[1], 1));
+  }
+
+  // One line per message: time, batch, channel and bytes.
+  std::ifstream file(path.c_str());
+  std::string line;
+  const char* expected[] = {" 0 0 a0 0f", " 0 1 42", " 1 1 0f"};
+  for (const char* end : expected) {
+    ASSERT_TRUE(static_cast<bool>(std::getline(file, line)));
+    std::istringstream stream(line);
+    long long time = -1;
+    stream >> time;
+    EXPECT_GE(time, 0);
+    std::string rest;
+    std::getline(stream, rest);
+    EXPECT_EQ(rest, end);
+  }
+  EXPECT_FALSE(static_cast<bool>(std::getline(file, line)));
+}
+
+TEST(FileSpiBus, WrongPath) {
+  ledmatrix::FileSpiBus bus("/nonexistent/directory/FileSpiBusTests.txt");
+  EXPECT_FALSE(bus.Setup(0));
+}
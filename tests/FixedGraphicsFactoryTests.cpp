@@ -0,0 +1,28 @@
+/**
+ * @file FixedGraphicsFactoryTests.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Test for the FixedGraphics factory
+ * @version 0.1
+ * @date 2019-06-06
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#include <gtest/gtest.h>
+
+#include "src/FixedGraphics.h"
+#include "src/FixedGraphicsFactory.h"
+
+TEST(FixedGraphicsFactory, GetIGraphics) {
+  ledmatrix::FixedGraphicsFactory<32, 8> factory;
+  std::unique_ptr<ledmatrix::IGraphics> pGraphics = factory.GetIGraphics();
+
+  EXPECT_EQ(pGraphics->GetWidth(), 32);
+  EXPECT_EQ(pGraphics->GetHeight(), 8);
+  typedef ledmatrix::FixedGraphics<32, 8> ScreenGraphics;
+  EXPECT_NE(dynamic_cast<ScreenGraphics*>(pGraphics.get()), nullptr);
+}
@@ -0,0 +1,158 @@
+/**
+ * @file FixedGraphicsTests.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Test for the FixedGraphics class template
+ * @version 0.1
+ * @date 2019-06-06
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+#include "src/FixedGraphics.h"
+#include "src/MonoColor8RowsGraphics.h"
+
+TEST(FixedGraphics, GetSetPixel) {
+  ledmatrix::FixedGraphics<16, 8> graphics;
+  EXPECT_EQ(graphics.GetWidth(), 16);
+  EXPECT_EQ(graphics.GetHeight(), 8);
+  EXPECT_EQ(sizeof(ledmatrix::FixedGraphics<16, 8>::Column), 1u);
+
+  graphics.SetPixel(0, 0, true);
+  graphics.SetPixel(15, 7, true);
+  EXPECT_EQ(graphics.GetPixel(0, 0), true);
+  EXPECT_EQ(graphics.GetPixel(0, 1), false);
+  EXPECT_EQ(graphics.GetPixel(15, 7), true);
+  graphics.SetPixel(15, 7, false);
+  EXPECT_EQ(graphics.GetPixel(15, 7), false);
+
+  // Pixels outside of the bounds are dropped and the size never changes
+  graphics.SetPixel(16, 0, true);
+  graphics.SetPixel(0, 8, true);
+  EXPECT_EQ(graphics.GetPixel(16, 0), false);
+  EXPECT_EQ(graphics.GetPixel(0, 8), false);
+  graphics.SetWidth(100);
+  EXPECT_EQ(graphics.GetWidth(), 16);
+
+  // Clear keeps the size
+  graphics.Clear();
+  EXPECT_EQ(graphics.GetWidth(), 16);
+  EXPECT_EQ(graphics.GetPixel(0, 0), false);
+}
+
+TEST(FixedGraphics, Columns) {
+  ledmatrix::FixedGraphics<6, 8> graphics;
+  const uint8_t columns[] = {0x01, 0x02, 0x04, 0x80};
+  uint8_t result[8];
+
+  // Columns on the right of the matrix are dropped
+  graphics.WriteColumns(4, 0, columns, sizeof(columns));
+  graphics.ReadColumns(2, 0, result, sizeof(result));
+  const uint8_t expected[] = {0x00, 0x00, 0x01, 0x02, 0, 0, 0, 0};
+  EXPECT_EQ(memcmp(result, expected, sizeof(expected)), 0);
+
+  graphics.FillColumns(0, 4, 6, 0x0F);
+  graphics.ReadColumns(0, 0, result, 6);
+  const uint8_t expectedFill[] = {0xF0, 0xF0, 0xF0, 0xF0, 0xF1, 0xF2};
+  EXPECT_EQ(memcmp(result, expectedFill, sizeof(expectedFill)), 0);
+
+  const uint8_t* view = nullptr;
+  ASSERT_EQ(graphics.GetColumnsView(4, 10, &view), 2);
+  EXPECT_EQ(view[0], 0xF1);
+  EXPECT_EQ(view[1], 0xF2);
+}
+
+TEST(FixedGraphics, ShiftRotate) {
+  ledmatrix::FixedGraphics<4, 8> graphics;
+  graphics.SetPixel(0, 0, true);
+  graphics.SetPixel(3, 7, true);
+
+  graphics.Rotate(ledmatrix::Left, 1);
+  EXPECT_EQ(graphics.GetPixel(3, 0), true);
+  EXPECT_EQ(graphics.GetPixel(2, 7), true);
+  graphics.Rotate(ledmatrix::Right, 5);
+  EXPECT_EQ(graphics.GetPixel(0, 0), true);
+  EXPECT_EQ(graphics.GetPixel(3, 7), true);
+
+  // Shifting brings blank columns in, the width does not change
+  graphics.Shift(ledmatrix::Right, 1);
+  EXPECT_EQ(graphics.GetWidth(), 4);
+  EXPECT_EQ(graphics.GetPixel(0, 0), false);
+  EXPECT_EQ(graphics.GetPixel(1, 0), true);
+  graphics.Shift(ledmatrix::Left, 1);
+  EXPECT_EQ(graphics.GetPixel(0, 0), true);
+  EXPECT_EQ(graphics.GetPixel(3, 7), false);
+
+  graphics.Rotate(ledmatrix::Up, 3);
+  EXPECT_EQ(graphics.GetPixel(0, 3), true);
+  graphics.Shift(ledmatrix::Down, 3);
+  EXPECT_EQ(graphics.GetPixel(0, 0), true);
+  graphics.Shift(ledmatrix::Left, 10);
+  EXPECT_EQ(graphics.GetPixel(0, 0), false);
+}
+
+TEST(FixedGraphics, TallColumns) {
+  ledmatrix::FixedGraphics<2, 12> graphics;
+  EXPECT_EQ(sizeof(ledmatrix::FixedGraphics<2, 12>::Column), 2u);
+  const uint8_t columns[] = {0xFF, 0x81};
+  uint8_t result[2];
+
+  // Rows beyond the height are dropped
+  graphics.WriteColumns(0, 8, columns, 2);
+  EXPECT_EQ(graphics.GetPixel(0, 11), true);
+  EXPECT_EQ(graphics.GetPixel(1, 8), true);
+  EXPECT_EQ(graphics.GetPixel(1, 11), false);
+  graphics.ReadColumns(0, 8, result, 2);
+  EXPECT_EQ(result[0], 0x0F);
+  EXPECT_EQ(result[1], 0x01);
+
+  // Wide columns are not exposed as bytes
+  const uint8_t* view = nullptr;
+  EXPECT_EQ(graphics.GetColumnsView(0, 2, &view), 0);
+
+  graphics.Rotate(ledmatrix::Up, 1);
+  EXPECT_EQ(graphics.GetPixel(0, 8), false);
+  EXPECT_EQ(graphics.GetPixel(0, 11), true);
+  EXPECT_EQ(graphics.GetPixel(1, 9), true);
+}
+
+TEST(FixedGraphics, CopyFrom) {
+  ledmatrix::MonoColor8RowsGraphics source;
+  const uint8_t columns[] = {0x81, 0x42, 0x24};
+  source.WriteColumns(0, 0, columns, sizeof(columns));
+  source.SetPixel(40, 0, true);
+
+  ledmatrix::FixedGraphics<32, 16> graphics;
+  graphics.SetPixel(5, 12, true);
+  graphics.SetPixel(6, 3, true);
+  graphics.CopyFrom(source);
+
+  // The rows and columns outside of the source are OFF.
+  EXPECT_EQ(graphics.GetColumns()[0], 0x81);
+  EXPECT_EQ(graphics.GetColumns()[1], 0x42);
+  EXPECT_EQ(graphics.GetColumns()[2], 0x24);
+  EXPECT_EQ(graphics.GetColumns()[5], 0x00);
+  EXPECT_EQ(graphics.GetColumns()[6], 0x00);
+  EXPECT_TRUE(graphics.GetDirtyColumns().Intersects(0, 32));
+
+  // Only the wanted columns are copied, the others are kept.
+  source.Reset();
+  graphics.ClearDirtyColumns();
+  graphics.CopyFrom(source, 1, 1);
+  EXPECT_EQ(graphics.GetColumns()[0], 0x81);
+  EXPECT_EQ(graphics.GetColumns()[1], 0x00);
+  EXPECT_EQ(graphics.GetColumns()[2], 0x24);
+  EXPECT_EQ(graphics.GetDirtyColumns().first, 1);
+  EXPECT_EQ(graphics.GetDirtyColumns().end, 2);
+
+  // Columns on the right of the matrix are ignored.
+  graphics.CopyFrom(source, 30, 10);
+  EXPECT_EQ(graphics.GetDirtyColumns().end, 32);
+}
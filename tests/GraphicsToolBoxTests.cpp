@@ -19,6 +19,7 @@
 #include "mocks/MockIGraphics.h"
 #include "mocks/MockIMatrixDrawable.h"
 #include "src/GraphicsToolBox.h"
+#include "src/MonoColor8RowsGraphics.h"
 
 TEST(GraphicsToolBox, WriteOnScreenFixed) {
   testing::NiceMock<ledmatrix::MockIFont> font;
@@ -190,4 +191,21 @@ TEST(GraphicsToolBox, WriteOnScreenMatrixDrawable) {
 
   ledmatrix::graphics_toolbox::WriteOnScreen(graphics, &matrixDrawable, startX,
                                              startY);
-}
\ No newline at end of file
+}
+
+TEST(GraphicsToolBox, WriteOnScreenMatrixDrawableTallGraphics) {
+  testing::NiceMock<ledmatrix::MockIMatrixDrawable> matrixDrawable;
+  ledmatrix::MonoColor16RowsGraphics graphics;
+
+  // A drawable of 2x12 pixels, all on, is not clipped at 8 rows anymore
+  ON_CALL(matrixDrawable, GetSize())
+      .WillByDefault(testing::Return(std::make_pair(2, 12)));
+  ON_CALL(matrixDrawable, GetPixel(testing::_, testing::_))
+      .WillByDefault(testing::Return(true));
+
+  ledmatrix::graphics_toolbox::WriteOnScreen(graphics, &matrixDrawable, 0, 2);
+  EXPECT_EQ(graphics.GetPixel(1, 1), false);
+  EXPECT_EQ(graphics.GetPixel(1, 2), true);
+  EXPECT_EQ(graphics.GetPixel(1, 13), true);
+  EXPECT_EQ(graphics.GetPixel(1, 14), false);
+}
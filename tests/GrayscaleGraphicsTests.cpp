@@ -0,0 +1,72 @@
+/**
+ * @file GrayscaleGraphicsTests.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Unit tests for the grayscale matrices
+ * @version 0.1
+ * @date 2019-06-18
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#include <gtest/gtest.h>
+
+#include "src/GrayscaleGraphics.h"
+
+TEST(GrayscaleGraphics, Levels) {
+  ledmatrix::GrayscaleGraphics<32, 8> graphics;
+  EXPECT_EQ(graphics.GetWidth(), 32);
+  EXPECT_EQ(graphics.GetHeight(), 8);
+
+  for (uint8_t level = 0; level <= 15; ++level) {
+    graphics.SetLevel(level, level % 8, level);
+  }
+  for (uint8_t level = 0; level <= 15; ++level) {
+    EXPECT_EQ(graphics.GetLevel(level, level % 8), level);
+    // Bit p of the level is the pixel of plane p.
+    for (uint8_t p = 0; p < 4; ++p) {
+      EXPECT_EQ(graphics.GetBitPlane(p).GetPixel(level, level % 8),
+                0 != (level & (0x1 << p)));
+    }
+  }
+
+  // Too bright levels are clamped, pixels outside are dropped.
+  graphics.SetLevel(20, 0, 200);
+  EXPECT_EQ(graphics.GetLevel(20, 0), 15);
+  graphics.SetLevel(40, 0, 3);
+  EXPECT_EQ(graphics.GetLevel(40, 0), 0);
+
+  graphics.Shift(ledmatrix::Left, 1);
+  EXPECT_EQ(graphics.GetLevel(19, 0), 15);
+  EXPECT_EQ(graphics.GetLevel(4, 5), 5);
+
+  graphics.Clear();
+  ledmatrix::FixedGraphics<32, 8> blank;
+  for (uint8_t p = 0; p < 4; ++p) {
+    EXPECT_EQ(graphics.GetBitPlane(p).GetContentHash(),
+              blank.GetContentHash());
+  }
+}
+
+TEST(GrayscaleGraphics, CopyFrom) {
+  ledmatrix::GrayscaleGraphics<64, 8> graphics;
+  graphics.SetLevel(3, 2, 9);
+  graphics.SetLevel(40, 7, 6);
+
+  ledmatrix::GrayscaleGraphics<256, 8> frame;
+  frame.CopyFrom(graphics);
+  EXPECT_EQ(frame.GetLevel(3, 2), 9);
+  EXPECT_EQ(frame.GetLevel(40, 7), 6);
+
+  // The hash depends on the levels, not only on the lit pixels.
+  uint64_t hash = frame.GetContentHash();
+  graphics.SetLevel(3, 2, 10);
+  frame.CopyFrom(graphics);
+  EXPECT_NE(frame.GetContentHash(), hash);
+  graphics.SetLevel(3, 2, 9);
+  frame.CopyFrom(graphics);
+  EXPECT_EQ(frame.GetContentHash(), hash);
+}
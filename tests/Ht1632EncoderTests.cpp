@@ -0,0 +1,328 @@
+/**
+ * @file Ht1632EncoderTests.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Unit tests for the HT1632 encoder
+ * @version 0.1
+ * @date 2019-06-12
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+#include <random>
+
+#include "src/Ht1632Encoder.h"
+#include "src/MonoColor8RowsGraphics.h"
+
+namespace {
+
+/**
+ * The original pixel by pixel encoder of Sure3208LedMatrix, used as reference.
+ */
+void ReferenceEncode(const ledmatrix::IGraphics& graphics, uint16_t firstX,
+                     unsigned char* data) {
+  memset(data, 0, ledmatrix::ht1632_encoder::FRAME_SIZE);
+
+  data[0] = 0xa0;
+  data[1] = 0x00;
+
+  uint16_t dataIndex = 1;
+  uint16_t positionWithinWord = 5;
+  for (uint16_t x = firstX; x < firstX + 32; ++x) {
+    for (uint16_t y = 0; y < graphics.GetHeight(); ++y) {
+      if (graphics.GetPixel(x, y)) {
+        data[dataIndex] |= (0x1 << positionWithinWord);
+      }
+
+      if (0 == positionWithinWord) {
+        positionWithinWord = 7;
+        ++dataIndex;
+      } else {
+        --positionWithinWord;
+      }
+    }
+  }
+
+  positionWithinWord = 5;
+  for (uint16_t y = 0; y < 6; ++y) {
+    if (graphics.GetPixel(firstX, y)) {
+      data[33] |= (0x1 << positionWithinWord);
+    }
+    --positionWithinWord;
+  }
+}
+
+/**
+ * ReferenceEncode() applied to raw columns.
+ */
+void ReferenceEncodeColumns(const uint8_t* columns, uint8_t* data) {
+  ledmatrix::MonoColor8RowsGraphics graphics;
+  graphics.WriteColumns(0, 0, columns,
+                        ledmatrix::ht1632_encoder::NUMBER_OF_COLUMNS);
+  ReferenceEncode(graphics, 0, data);
+}
+
+/**
+ * Apply a write command to the memory of a simulated HT1632 (one nibble per
+ * address, row 0 in the most significant bit). Incomplete nibbles at the end
+ * of the command are ignored.
+ */
+void ApplyCommand(const uint8_t* data, uint16_t size, uint8_t* memory) {
+  uint32_t numberOfBits = 8 * size;
+  auto getBits = [&](uint32_t position, uint16_t count) {
+    uint16_t value = 0;
+    for (uint16_t i = 0; i < count; ++i) {
+      uint32_t bit = position + i;
+      value = (value << 1) | ((data[bit / 8] >> (7 - bit % 8)) & 0x1);
+    }
+    return (value);
+  };
+  ASSERT_EQ(getBits(0, 3), 0x5);
+  uint16_t address = getBits(3, 7);
+  for (uint32_t position = 10; position + 4 <= numberOfBits; position += 4) {
+    memory[address] = static_cast<uint8_t>(getBits(position, 4));
+    address = (address + 1) % ledmatrix::ht1632_encoder::NUMBER_OF_ADDRESSES;
+  }
+}
+
+/**
+ * Fill \a memory with what the HT1632 holds when showing \a columns.
+ */
+void ColumnsToMemory(const uint8_t* columns, uint8_t* memory) {
+  uint8_t data[ledmatrix::ht1632_encoder::FRAME_SIZE];
+  ReferenceEncodeColumns(columns, data);
+  ApplyCommand(data, sizeof(data), memory);
+}
+
+}  // namespace
+
+TEST(Ht1632Encoder, KnownFrames) {
+  uint8_t columns[ledmatrix::ht1632_encoder::NUMBER_OF_COLUMNS];
+  uint8_t data[ledmatrix::ht1632_encoder::FRAME_SIZE];
+  uint8_t expected[ledmatrix::ht1632_encoder::FRAME_SIZE];
+
+  // Blank screen: only the header
+  memset(columns, 0, sizeof(columns));
+  memset(expected, 0, sizeof(expected));
+  expected[0] = 0xa0;
+  ledmatrix::ht1632_encoder::Encode(columns, data);
+  EXPECT_EQ(memcmp(data, expected, sizeof(data)), 0);
+  ledmatrix::ht1632_encoder::EncodePortable(columns, data);
+  EXPECT_EQ(memcmp(data, expected, sizeof(data)), 0);
+
+  // Row 0 of the first column is the bit after the address, and is repeated
+  // in the last byte. Row 7 of the last column is the last bit.
+  columns[0] = 0x01;
+  columns[31] = 0x80;
+  expected[1] = 0x20;
+  expected[33] = 0x60;
+  ledmatrix::ht1632_encoder::Encode(columns, data);
+  EXPECT_EQ(memcmp(data, expected, sizeof(data)), 0);
+  ledmatrix::ht1632_encoder::EncodePortable(columns, data);
+  EXPECT_EQ(memcmp(data, expected, sizeof(data)), 0);
+}
+
+TEST(Ht1632Encoder, SameAsReferenceEncoder) {
+  std::mt19937 generator(1234);
+  std::uniform_int_distribution<int> byteDistribution(0, 255);
+
+  ledmatrix::MonoColor8RowsGraphics graphics;
+  uint8_t columns[ledmatrix::ht1632_encoder::NUMBER_OF_COLUMNS];
+  unsigned char expected[ledmatrix::ht1632_encoder::FRAME_SIZE];
+  uint8_t data[ledmatrix::ht1632_encoder::FRAME_SIZE];
+
+  for (int i = 0; i < 1000; ++i) {
+    for (uint8_t& column : columns) {
+      column = static_cast<uint8_t>(byteDistribution(generator));
+    }
+    graphics.WriteColumns(0, 0, columns, sizeof(columns));
+    ReferenceEncode(graphics, 0, expected);
+
+    memset(data, 0x55, sizeof(data));
+    ledmatrix::ht1632_encoder::Encode(columns, data);
+    ASSERT_EQ(memcmp(data, expected, sizeof(data)), 0);
+
+    memset(data, 0x55, sizeof(data));
+    ledmatrix::ht1632_encoder::EncodePortable(columns, data);
+    ASSERT_EQ(memcmp(data, expected, sizeof(data)), 0);
+  }
+}
+
+TEST(Ht1632Encoder, EncodeScrolled) {
+  std::mt19937 generator(4321);
+  std::uniform_int_distribution<int> byteDistribution(0, 255);
+  std::uniform_int_distribution<int> scrollDistribution(-40, 40);
+
+  // Move a window of 32 columns over a long random tape.
+  uint8_t tape[200];
+  for (uint8_t& column : tape) {
+    column = static_cast<uint8_t>(byteDistribution(generator));
+  }
+  int position = 80;
+  uint8_t data[ledmatrix::ht1632_encoder::FRAME_SIZE];
+  uint8_t expected[ledmatrix::ht1632_encoder::FRAME_SIZE];
+  ledmatrix::ht1632_encoder::Encode(tape + position, data);
+
+  for (int i = 0; i < 1000; ++i) {
+    int16_t scroll = static_cast<int16_t>(scrollDistribution(generator));
+    if ((position + scroll < 0) ||
+        (position + scroll > static_cast<int>(sizeof(tape)) - 32)) {
+      scroll = static_cast<int16_t>(-scroll);
+    }
+    position += scroll;
+
+    ledmatrix::ht1632_encoder::EncodeScrolled(tape + position, scroll, data);
+    ledmatrix::ht1632_encoder::Encode(tape + position, expected);
+    ASSERT_EQ(memcmp(data, expected, sizeof(data)), 0) << "scroll " << scroll;
+  }
+}
+
+TEST(Ht1632Encoder, EncodeBurst) {
+  std::mt19937 generator(5678);
+  std::uniform_int_distribution<int> byteDistribution(0, 255);
+  uint8_t columns[ledmatrix::ht1632_encoder::NUMBER_OF_COLUMNS];
+  for (uint8_t& column : columns) {
+    column = static_cast<uint8_t>(byteDistribution(generator));
+  }
+  uint8_t expected[ledmatrix::ht1632_encoder::FRAME_SIZE];
+  uint8_t data[ledmatrix::ht1632_encoder::FRAME_SIZE];
+
+  // The whole matrix is the usual command
+  ledmatrix::ht1632_encoder::Burst burst = {
+      0, ledmatrix::ht1632_encoder::NUMBER_OF_ADDRESSES};
+  ReferenceEncodeColumns(columns, expected);
+  EXPECT_EQ(ledmatrix::ht1632_encoder::EncodeBurst(columns, burst, data),
+            ledmatrix::ht1632_encoder::FRAME_SIZE);
+  EXPECT_EQ(memcmp(data, expected, sizeof(data)), 0);
+
+  // Rows 0 to 3 of column 1 (address 2), completed by rows 4 and 5.
+  memset(columns, 0, sizeof(columns));
+  columns[1] = 0x11;
+  burst.firstAddress = 2;
+  burst.numberOfNibbles = 1;
+  ASSERT_EQ(ledmatrix::ht1632_encoder::EncodeBurst(columns, burst, data), 2);
+  EXPECT_EQ(data[0], 0xa0);
+  EXPECT_EQ(data[1], 0xa2);
+
+  // Any burst writes the wanted addresses and leaves the others unchanged.
+  for (uint16_t first = 0;
+       first < ledmatrix::ht1632_encoder::NUMBER_OF_ADDRESSES; ++first) {
+    for (uint16_t count = 1;
+         count <= ledmatrix::ht1632_encoder::NUMBER_OF_ADDRESSES; ++count) {
+      for (uint8_t& column : columns) {
+        column = static_cast<uint8_t>(byteDistribution(generator));
+      }
+      uint8_t memory[ledmatrix::ht1632_encoder::NUMBER_OF_ADDRESSES];
+      uint8_t expectedMemory[ledmatrix::ht1632_encoder::NUMBER_OF_ADDRESSES];
+      memset(memory, 0xff, sizeof(memory));
+      memset(expectedMemory, 0xff, sizeof(expectedMemory));
+      ColumnsToMemory(columns, expectedMemory);
+      burst.firstAddress = first;
+      burst.numberOfNibbles = count;
+      uint16_t size =
+          ledmatrix::ht1632_encoder::EncodeBurst(columns, burst, data);
+      ApplyCommand(data, size, memory);
+      for (uint16_t i = 0; i < count; ++i) {
+        uint16_t address =
+            (first + i) % ledmatrix::ht1632_encoder::NUMBER_OF_ADDRESSES;
+        ASSERT_EQ(memory[address], expectedMemory[address]);
+      }
+      // The padding only rewrites the next address with its own pixels.
+      for (uint16_t address = 0;
+           address < ledmatrix::ht1632_encoder::NUMBER_OF_ADDRESSES;
+           ++address) {
+        ASSERT_TRUE((0xff == memory[address]) ||
+                    (memory[address] == expectedMemory[address]));
+      }
+    }
+  }
+}
+
+TEST(Ht1632Encoder, PlanBursts) {
+  uint8_t previous[ledmatrix::ht1632_encoder::NUMBER_OF_COLUMNS];
+  uint8_t columns[ledmatrix::ht1632_encoder::NUMBER_OF_COLUMNS];
+  ledmatrix::ht1632_encoder::Burst
+      bursts[ledmatrix::ht1632_encoder::MAX_NUMBER_OF_BURSTS];
+  memset(previous, 0, sizeof(previous));
+  memset(columns, 0, sizeof(columns));
+
+  // Nothing to write
+  EXPECT_EQ(ledmatrix::ht1632_encoder::PlanBursts(previous, columns, bursts),
+            0);
+
+  // Row 7 of column 3 is at address 7
+  columns[3] = 0x80;
+  ASSERT_EQ(ledmatrix::ht1632_encoder::PlanBursts(previous, columns, bursts),
+            1);
+  EXPECT_EQ(bursts[0].firstAddress, 7);
+  EXPECT_EQ(bursts[0].numberOfNibbles, 1);
+
+  // Close addresses are written together, far ones separately
+  columns[4] = 0x80;
+  columns[25] = 0x01;
+  ASSERT_EQ(ledmatrix::ht1632_encoder::PlanBursts(previous, columns, bursts),
+            2);
+  EXPECT_EQ(bursts[0].firstAddress, 7);
+  EXPECT_EQ(bursts[0].numberOfNibbles, 3);
+  EXPECT_EQ(bursts[1].firstAddress, 50);
+  EXPECT_EQ(bursts[1].numberOfNibbles, 1);
+
+  // Everything changed: the whole matrix is written at once
+  memset(columns, 0x11, sizeof(columns));
+  ASSERT_EQ(ledmatrix::ht1632_encoder::PlanBursts(previous, columns, bursts),
+            1);
+  EXPECT_EQ(bursts[0].firstAddress, 0);
+  EXPECT_EQ(bursts[0].numberOfNibbles,
+            ledmatrix::ht1632_encoder::NUMBER_OF_ADDRESSES);
+}
+
+TEST(Ht1632Encoder, PlannedBurstsUpdateTheMatrix) {
+  std::mt19937 generator(8765);
+  std::uniform_int_distribution<int> byteDistribution(0, 255);
+  std::uniform_int_distribution<int> columnDistribution(
+      0, ledmatrix::ht1632_encoder::NUMBER_OF_COLUMNS - 1);
+
+  uint8_t columns[ledmatrix::ht1632_encoder::NUMBER_OF_COLUMNS];
+  uint8_t previous[ledmatrix::ht1632_encoder::NUMBER_OF_COLUMNS];
+  for (uint8_t& column : columns) {
+    column = static_cast<uint8_t>(byteDistribution(generator));
+  }
+  uint8_t memory[ledmatrix::ht1632_encoder::NUMBER_OF_ADDRESSES];
+  ColumnsToMemory(columns, memory);
+
+  ledmatrix::ht1632_encoder::Burst
+      bursts[ledmatrix::ht1632_encoder::MAX_NUMBER_OF_BURSTS];
+  uint8_t data[ledmatrix::ht1632_encoder::FRAME_SIZE];
+  for (int i = 0; i < 1000; ++i) {
+    // Modify a few random columns
+    memcpy(previous, columns, sizeof(columns));
+    int numberOfChanges = columnDistribution(generator) % 6;
+    for (int j = 0; j < numberOfChanges; ++j) {
+      columns[columnDistribution(generator)] =
+          static_cast<uint8_t>(byteDistribution(generator));
+    }
+
+    uint16_t numberOfBursts =
+        ledmatrix::ht1632_encoder::PlanBursts(previous, columns, bursts);
+    uint32_t cost = 0;
+    for (uint16_t j = 0; j < numberOfBursts; ++j) {
+      uint16_t size =
+          ledmatrix::ht1632_encoder::EncodeBurst(columns, bursts[j], data);
+      ApplyCommand(data, size, memory);
+      cost += size + ledmatrix::ht1632_encoder::BURST_OVERHEAD;
+    }
+    EXPECT_LE(cost, ledmatrix::ht1632_encoder::FRAME_SIZE +
+                        ledmatrix::ht1632_encoder::BURST_OVERHEAD);
+
+    uint8_t expectedMemory[ledmatrix::ht1632_encoder::NUMBER_OF_ADDRESSES];
+    ColumnsToMemory(columns, expectedMemory);
+    ASSERT_EQ(memcmp(memory, expectedMemory, sizeof(memory)), 0);
+  }
+}
@@ -15,6 +15,8 @@
 
 #include <gtest/gtest.h>
 
+#include <string.h>
+
 #include "src/MonoColor8RowsGraphics.h"
 
 TEST(MonoColor8RowsGraphics, GetSetPixel) {
@@ -185,3 +187,225 @@ TEST(MonoColor8RowsGraphics, Shift) {
   EXPECT_EQ(graphics.GetWidth(), 5);
   EXPECT_EQ(graphics.GetPixel(2, 3), true);
 }
+
+TEST(MonoColor8RowsGraphics, ShiftRightLongTape) {
+  ledmatrix::MonoColor8RowsGraphics graphics;
+  const uint16_t width = 1000;
+
+  for (uint16_t x = 0; x < width; ++x) {
+    graphics.SetPixel(x, x % MONO_COLOR_GRAPHICS_NUMBER_OF_ROWS, true);
+  }
+
+  // Add blank columns on the left, one at a time.
+  for (uint16_t i = 0; i < width; ++i) {
+    graphics.Shift(ledmatrix::Right, 1);
+  }
+  EXPECT_EQ(graphics.GetWidth(), 2 * width);
+  for (uint16_t x = 0; x < width; ++x) {
+    for (uint16_t y = 0; y < MONO_COLOR_GRAPHICS_NUMBER_OF_ROWS; ++y) {
+      ASSERT_EQ(graphics.GetPixel(x, y), false);
+      ASSERT_EQ(graphics.GetPixel(x + width, y),
+                (x % MONO_COLOR_GRAPHICS_NUMBER_OF_ROWS) == y);
+    }
+  }
+
+  // The matrix can still grow on the right after the ring has wrapped.
+  graphics.SetPixel(2 * width + 3, 1, true);
+  EXPECT_EQ(graphics.GetWidth(), 2 * width + 4);
+  EXPECT_EQ(graphics.GetPixel(2 * width + 3, 1), true);
+  EXPECT_EQ(graphics.GetPixel(width + 1, 1), true);
+  EXPECT_EQ(graphics.GetPixel(2 * width, 0), false);
+}
+
+TEST(MonoColor8RowsGraphics, RotateWrappedTape) {
+  ledmatrix::MonoColor8RowsGraphics graphics;
+
+  graphics.SetPixel(0, 0, true);
+  graphics.SetPixel(1, 1, true);
+  graphics.SetPixel(2, 2, true);
+  // Wrap the ring before rotating it.
+  graphics.Shift(ledmatrix::Right, 3);
+  EXPECT_EQ(graphics.GetWidth(), 6);
+
+  graphics.Rotate(ledmatrix::Left, 4);
+  EXPECT_EQ(graphics.GetPixel(5, 0), true);
+  EXPECT_EQ(graphics.GetPixel(0, 1), true);
+  EXPECT_EQ(graphics.GetPixel(1, 2), true);
+
+  for (uint16_t i = 0; i < 6; ++i) {
+    graphics.Rotate(ledmatrix::Right, 1);
+  }
+  EXPECT_EQ(graphics.GetPixel(5, 0), true);
+  EXPECT_EQ(graphics.GetPixel(0, 1), true);
+  EXPECT_EQ(graphics.GetPixel(1, 2), true);
+
+  // Growing after a rotation keeps the rotated content.
+  graphics.SetPixel(7, 7, true);
+  EXPECT_EQ(graphics.GetWidth(), 8);
+  EXPECT_EQ(graphics.GetPixel(5, 0), true);
+  EXPECT_EQ(graphics.GetPixel(6, 0), false);
+  EXPECT_EQ(graphics.GetPixel(7, 7), true);
+
+  graphics.Clear();
+  graphics.SetWidth(4);
+  for (uint16_t x = 0; x < 4; ++x) {
+    for (uint16_t y = 0; y < MONO_COLOR_GRAPHICS_NUMBER_OF_ROWS; ++y) {
+      EXPECT_EQ(graphics.GetPixel(x, y), false);
+    }
+  }
+}
+
+TEST(MonoColor8RowsGraphics, EndlessScrolling) {
+  ledmatrix::MonoColor8RowsGraphics graphics;
+  const uint16_t screenSize = 32;
+  const uint32_t numberOfSteps = 100000;
+
+  graphics.SetWidth(screenSize);
+  // Scroll far beyond the range of a 16 bits origin, writing a new column on
+  // the right of the screen at each step.
+  for (uint32_t i = 0; i < numberOfSteps; ++i) {
+    graphics.Shift(ledmatrix::Left, 1);
+    graphics.SetPixel(screenSize - 1, i % MONO_COLOR_GRAPHICS_NUMBER_OF_ROWS,
+                      true);
+    ASSERT_EQ(graphics.GetWidth(), screenSize);
+  }
+
+  for (uint16_t x = 0; x < screenSize; ++x) {
+    uint32_t i = numberOfSteps - screenSize + x;
+    for (uint16_t y = 0; y < MONO_COLOR_GRAPHICS_NUMBER_OF_ROWS; ++y) {
+      EXPECT_EQ(graphics.GetPixel(x, y),
+                (i % MONO_COLOR_GRAPHICS_NUMBER_OF_ROWS) == y);
+    }
+  }
+
+  // Shifting past the end leaves an empty matrix.
+  graphics.Shift(ledmatrix::Left, screenSize + 10);
+  EXPECT_EQ(graphics.GetWidth(), 0);
+  graphics.Shift(ledmatrix::Right, 1);
+  EXPECT_EQ(graphics.GetWidth(), 1);
+  EXPECT_EQ(graphics.GetPixel(0, (numberOfSteps - 1) %
+                                     MONO_COLOR_GRAPHICS_NUMBER_OF_ROWS),
+            true);
+}
+
+TEST(MonoColor8RowsGraphics, Columns) {
+  ledmatrix::MonoColor8RowsGraphics graphics;
+  const uint8_t columns[] = {0x01, 0x02, 0x04, 0x80};
+  uint8_t result[6];
+
+  // Writing outside of the boundaries increases the width
+  graphics.WriteColumns(2, 0, columns, sizeof(columns));
+  EXPECT_EQ(graphics.GetWidth(), 6);
+  EXPECT_EQ(graphics.GetPixel(2, 0), true);
+  EXPECT_EQ(graphics.GetPixel(3, 1), true);
+  EXPECT_EQ(graphics.GetPixel(5, 7), true);
+
+  // Columns outside of the boundaries are read as blank
+  graphics.ReadColumns(0, 0, result, sizeof(result));
+  const uint8_t expected[] = {0x00, 0x00, 0x01, 0x02, 0x04, 0x80};
+  EXPECT_EQ(memcmp(result, expected, sizeof(expected)), 0);
+  graphics.ReadColumns(4, 0, result, sizeof(result));
+  const uint8_t expectedEnd[] = {0x04, 0x80, 0x00, 0x00, 0x00, 0x00};
+  EXPECT_EQ(memcmp(result, expectedEnd, sizeof(expectedEnd)), 0);
+  EXPECT_EQ(graphics.GetWidth(), 6);
+
+  // Columns with an offset only touch the rows from y
+  graphics.WriteColumns(0, 4, columns, 2);
+  EXPECT_EQ(graphics.GetPixel(0, 4), true);
+  EXPECT_EQ(graphics.GetPixel(1, 5), true);
+  graphics.ReadColumns(2, 2, result, 4);
+  const uint8_t expectedShifted[] = {0x00, 0x00, 0x01, 0x20};
+  EXPECT_EQ(memcmp(result, expectedShifted, sizeof(expectedShifted)), 0);
+
+  // Fill a range, only the rows from 4 are changed
+  graphics.FillColumns(1, 4, 3, 0x0F);
+  graphics.ReadColumns(0, 0, result, 5);
+  const uint8_t expectedFill[] = {0x10, 0xF0, 0xF1, 0xF2, 0x04};
+  EXPECT_EQ(memcmp(result, expectedFill, sizeof(expectedFill)), 0);
+
+  // Clear a range
+  graphics.FillColumns(0, 0, 6, 0);
+  graphics.ReadColumns(0, 0, result, sizeof(result));
+  for (uint8_t column : result) {
+    EXPECT_EQ(column, 0);
+  }
+}
+
+TEST(MonoColor8RowsGraphics, ColumnsWrappedTape) {
+  ledmatrix::MonoColor8RowsGraphics graphics;
+  uint8_t columns[8];
+  uint8_t result[8];
+  for (uint8_t i = 0; i < sizeof(columns); ++i) {
+    columns[i] = i + 1;
+  }
+
+  // Shifting right moves the start of the tape before the end of the storage,
+  // so the columns are split in two parts.
+  graphics.SetWidth(8);
+  graphics.Shift(ledmatrix::Right, 4);
+  graphics.WriteColumns(0, 0, columns, sizeof(columns));
+  graphics.ReadColumns(0, 0, result, sizeof(result));
+  EXPECT_EQ(memcmp(result, columns, sizeof(columns)), 0);
+  for (uint16_t x = 0; x < sizeof(columns); ++x) {
+    for (uint16_t y = 0; y < MONO_COLOR_GRAPHICS_NUMBER_OF_ROWS; ++y) {
+      EXPECT_EQ(graphics.GetPixel(x, y), 0 != (columns[x] & (0x1 << y)));
+    }
+  }
+}
+
+TEST(MonoColor8RowsGraphics, DirtyColumnsWrappedTape) {
+  ledmatrix::MonoColor8RowsGraphics graphics;
+  const uint8_t columns[] = {0x01, 0x02, 0x04};
+
+  // The dirty columns are the ones of the matrix, not of the storage.
+  graphics.SetWidth(8);
+  graphics.Shift(ledmatrix::Right, 4);
+  graphics.ClearDirtyColumns();
+  graphics.WriteColumns(3, 0, columns, sizeof(columns));
+  EXPECT_EQ(graphics.GetDirtyColumns().first, 3);
+  EXPECT_EQ(graphics.GetDirtyColumns().end, 6);
+
+  graphics.ClearDirtyColumns();
+  graphics.SetPixel(7, 0, true);
+  EXPECT_EQ(graphics.GetDirtyColumns().first, 7);
+  EXPECT_EQ(graphics.GetDirtyColumns().end, 8);
+
+  // Rotating moves every column.
+  graphics.ClearDirtyColumns();
+  graphics.Rotate(ledmatrix::Left, 2);
+  EXPECT_TRUE(graphics.GetDirtyColumns().Intersects(0, 1));
+  EXPECT_TRUE(graphics.GetDirtyColumns().Intersects(7, 1));
+}
+
+TEST(MonoColor8RowsGraphics, ColumnsView) {
+  ledmatrix::MonoColor8RowsGraphics graphics;
+  const uint8_t* view = nullptr;
+  uint8_t columns[8];
+  for (uint8_t i = 0; i < sizeof(columns); ++i) {
+    columns[i] = i + 1;
+  }
+
+  // Nothing is stored yet
+  EXPECT_EQ(graphics.GetColumnsView(0, 4, &view), 0);
+
+  graphics.WriteColumns(0, 0, columns, sizeof(columns));
+  ASSERT_EQ(graphics.GetColumnsView(2, 4, &view), 4);
+  EXPECT_EQ(memcmp(view, columns + 2, 4), 0);
+
+  // The view stops at the last stored column
+  ASSERT_EQ(graphics.GetColumnsView(6, 10, &view), 2);
+  EXPECT_EQ(memcmp(view, columns + 6, 2), 0);
+  EXPECT_EQ(graphics.GetColumnsView(8, 10, &view), 0);
+
+  // Once the tape wraps in the ring, two views are needed
+  graphics.Shift(ledmatrix::Right, 4);
+  graphics.WriteColumns(0, 0, columns, sizeof(columns));
+  uint16_t first = graphics.GetColumnsView(0, sizeof(columns), &view);
+  ASSERT_GT(first, 0);
+  ASSERT_LT(first, sizeof(columns));
+  EXPECT_EQ(memcmp(view, columns, first), 0);
+  uint16_t second =
+      graphics.GetColumnsView(first, sizeof(columns) - first, &view);
+  ASSERT_EQ(first + second, sizeof(columns));
+  EXPECT_EQ(memcmp(view, columns + first, second), 0);
+}
@@ -0,0 +1,108 @@
+/**
+ * @file MonoColorGraphicsTests.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Test for the MonoColorGraphics with more than 8 rows
+ * @version 0.1
+ * @date 2019-06-08
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+#include "src/GraphicsFactory.h"
+#include "src/MonoColor8RowsGraphics.h"
+
+TEST(MonoColorGraphics, GetSetPixel16Rows) {
+  ledmatrix::MonoColor16RowsGraphics graphics;
+  EXPECT_EQ(graphics.GetHeight(), 16);
+
+  graphics.SetPixel(0, 0, true);
+  graphics.SetPixel(0, 15, true);
+  graphics.SetPixel(3, 9, true);
+  EXPECT_EQ(graphics.GetWidth(), 4);
+  EXPECT_EQ(graphics.GetPixel(0, 0), true);
+  EXPECT_EQ(graphics.GetPixel(0, 15), true);
+  EXPECT_EQ(graphics.GetPixel(3, 9), true);
+  EXPECT_EQ(graphics.GetPixel(3, 8), false);
+  graphics.SetPixel(0, 15, false);
+  EXPECT_EQ(graphics.GetPixel(0, 15), false);
+
+  // Outside of the bounds
+  graphics.SetPixel(1, 16, true);
+  EXPECT_EQ(graphics.GetPixel(1, 16), false);
+}
+
+TEST(MonoColorGraphics, ShiftRotate32Rows) {
+  ledmatrix::MonoColor32RowsGraphics graphics;
+  EXPECT_EQ(graphics.GetHeight(), 32);
+
+  graphics.SetPixel(0, 31, true);
+  graphics.SetPixel(1, 0, true);
+
+  graphics.Rotate(ledmatrix::Up, 20);
+  EXPECT_EQ(graphics.GetPixel(0, 31), false);
+  EXPECT_EQ(graphics.GetPixel(1, 20), true);
+  graphics.Rotate(ledmatrix::Down, 20);
+  EXPECT_EQ(graphics.GetPixel(1, 0), true);
+
+  graphics.Shift(ledmatrix::Right, 2);
+  EXPECT_EQ(graphics.GetWidth(), 4);
+  EXPECT_EQ(graphics.GetPixel(3, 0), true);
+  graphics.Rotate(ledmatrix::Left, 3);
+  EXPECT_EQ(graphics.GetPixel(0, 0), true);
+
+  graphics.Rotate(ledmatrix::Up, 32);
+  EXPECT_EQ(graphics.GetPixel(0, 0), false);
+}
+
+TEST(MonoColorGraphics, Columns16Rows) {
+  ledmatrix::MonoColor16RowsGraphics graphics;
+  const uint8_t columns[] = {0x81, 0xFF};
+  uint8_t result[3];
+
+  // Write the upper panel only
+  graphics.WriteColumns(0, 8, columns, sizeof(columns));
+  EXPECT_EQ(graphics.GetPixel(0, 8), true);
+  EXPECT_EQ(graphics.GetPixel(0, 15), true);
+  EXPECT_EQ(graphics.GetPixel(0, 7), false);
+  graphics.ReadColumns(0, 0, result, sizeof(result));
+  EXPECT_EQ(result[0], 0x00);
+  graphics.ReadColumns(0, 8, result, sizeof(result));
+  EXPECT_EQ(result[0], 0x81);
+  EXPECT_EQ(result[1], 0xFF);
+  EXPECT_EQ(result[2], 0x00);
+
+  // Rows beyond the height are dropped
+  graphics.FillColumns(0, 12, 2, 0xFF);
+  graphics.ReadColumns(0, 8, result, 2);
+  EXPECT_EQ(result[0], 0xF1);
+  graphics.ReadColumns(0, 12, result, 2);
+  EXPECT_EQ(result[0], 0x0F);
+
+  // The storage is not made of bytes, so it cannot be viewed as such
+  const uint8_t* view = nullptr;
+  EXPECT_EQ(graphics.GetColumnsView(0, 2, &view), 0);
+}
+
+TEST(MonoColorGraphics, Factory) {
+  std::unique_ptr<ledmatrix::IGraphics> pGraphics =
+      ledmatrix::GraphicsFactory::CreateFactory(
+          ledmatrix::GraphicsFactory::MonoColor16RowsGraphicsFactoryType)
+          ->GetIGraphics();
+  EXPECT_EQ(pGraphics->GetHeight(), 16);
+  EXPECT_NE(dynamic_cast<ledmatrix::MonoColor16RowsGraphics*>(pGraphics.get()),
+            nullptr);
+
+  pGraphics =
+      ledmatrix::GraphicsFactory::CreateFactory(
+          ledmatrix::GraphicsFactory::MonoColor32RowsGraphicsFactoryType)
+          ->GetIGraphics();
+  EXPECT_EQ(pGraphics->GetHeight(), 32);
+}
@@ -0,0 +1,93 @@
+/**
+ * @file MpscRingBufferTests.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Unit tests for the multiple producers lock free queue
+ * @version 0.1
+ * @date 2019-06-25
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "src/MpscRingBuffer.h"
+
+TEST(MpscRingBuffer, PushPop) {
+  ledmatrix::MpscRingBuffer<std::unique_ptr<int>, 4> buffer;
+  std::unique_ptr<int> value;
+
+  // Nothing pushed yet
+  EXPECT_TRUE(buffer.IsEmpty());
+  EXPECT_FALSE(buffer.TryPop(&value));
+
+  // Fill the queue, the elements are moved in.
+  for (int i = 0; i < 4; ++i) {
+    std::unique_ptr<int> element(new int(i));
+    ASSERT_TRUE(buffer.TryPush(std::move(element)));
+    EXPECT_EQ(element, nullptr);
+  }
+  EXPECT_FALSE(buffer.IsEmpty());
+  std::unique_ptr<int> extra(new int(4));
+  EXPECT_FALSE(buffer.TryPush(std::move(extra)));
+  ASSERT_NE(extra, nullptr);
+
+  // The elements come out in order, and make some room.
+  ASSERT_TRUE(buffer.TryPop(&value));
+  EXPECT_EQ(*value, 0);
+  EXPECT_TRUE(buffer.TryPush(std::move(extra)));
+  for (int i = 1; i <= 4; ++i) {
+    ASSERT_TRUE(buffer.TryPop(&value));
+    EXPECT_EQ(*value, i);
+  }
+  EXPECT_TRUE(buffer.IsEmpty());
+  EXPECT_FALSE(buffer.TryPop(&value));
+}
+
+TEST(MpscRingBuffer, ConcurrentProducers) {
+  ledmatrix::MpscRingBuffer<uint32_t, 8> buffer;
+  const uint32_t numberOfProducers = 3;
+  const uint32_t numberOfElements = 10000;
+
+  // Every producer pushes its number in the high bits and a counter in the
+  // low bits.
+  std::vector<std::thread> producers;
+  for (uint32_t producer = 0; producer < numberOfProducers; ++producer) {
+    producers.push_back(std::thread([&buffer, producer]() {
+      for (uint32_t i = 1; i <= numberOfElements; ++i) {
+        uint32_t element = (producer << 16) | i;
+        while (!buffer.TryPush(std::move(element))) {
+          std::this_thread::yield();
+        }
+      }
+    }));
+  }
+
+  // Nothing is lost, and the elements of a producer stay in order.
+  std::vector<uint32_t> lastElements(numberOfProducers, 0);
+  uint32_t numberOfPoppedElements = 0;
+  while (numberOfPoppedElements < numberOfProducers * numberOfElements) {
+    uint32_t element = 0;
+    if (buffer.TryPop(&element)) {
+      uint32_t producer = element >> 16;
+      ASSERT_LT(producer, numberOfProducers);
+      ASSERT_EQ(element & 0xffff, lastElements[producer] + 1);
+      lastElements[producer] = element & 0xffff;
+      ++numberOfPoppedElements;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+
+  EXPECT_TRUE(buffer.IsEmpty());
+}
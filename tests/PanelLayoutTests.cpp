@@ -0,0 +1,41 @@
+/**
+ * @file PanelLayoutTests.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Unit tests for the panel layouts
+ * @version 0.1
+ * @date 2019-06-16
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#include <gtest/gtest.h>
+
+#include "src/PanelLayout.h"
+
+TEST(PanelLayout, CreateRow) {
+  ledmatrix::PanelLayout layout = ledmatrix::panel_layout::CreateRow(3);
+  ASSERT_EQ(layout.size(), 3u);
+  for (uint16_t i = 0; i < layout.size(); ++i) {
+    EXPECT_EQ(layout[i].channel, i);
+    EXPECT_EQ(layout[i].x, 32 * i);
+    EXPECT_EQ(layout[i].y, 0);
+    EXPECT_EQ(layout[i].orientation, ledmatrix::Normal);
+  }
+  EXPECT_EQ(ledmatrix::panel_layout::GetWidth(layout), 96);
+  EXPECT_EQ(ledmatrix::panel_layout::GetHeight(layout), 8);
+
+  layout = ledmatrix::panel_layout::CreateRow(0);
+  EXPECT_EQ(ledmatrix::panel_layout::GetWidth(layout), 0);
+  EXPECT_EQ(ledmatrix::panel_layout::GetHeight(layout), 0);
+}
+
+TEST(PanelLayout, Size) {
+  ledmatrix::PanelLayout layout = {{0, 0, 0, ledmatrix::Normal},
+                                   {1, 16, 8, ledmatrix::Rotated180}};
+  EXPECT_EQ(ledmatrix::panel_layout::GetWidth(layout), 48);
+  EXPECT_EQ(ledmatrix::panel_layout::GetHeight(layout), 16);
+}
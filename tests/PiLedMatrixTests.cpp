@@ -15,7 +15,14 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include "src/PiLedMatrix.h"
+#include "src/RecordingSpiBus.h"
+#include "src/Sure3208LedMatrix.h"
 
 TEST(PiLedMatrix, StartAndStop) {
     ledmatrix::PiLedMatrix piLedMatrix;
@@ -50,3 +57,67 @@ TEST(PiLedMatrix, DeallocatingDestructor)
     EXPECT_FALSE(piLedMatrix->IsStarted());
     delete piLedMatrix;
 }
+
+TEST(PiLedMatrix, AsyncOutput)
+{
+    ledmatrix::PiLedMatrix piLedMatrix(2, true);
+    piLedMatrix.Start();
+    piLedMatrix.AddMessage("a");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    piLedMatrix.Stop();
+    EXPECT_FALSE(piLedMatrix.IsStarted());
+}
+
+TEST(PiLedMatrix, InjectedHardware)
+{
+    std::unique_ptr<ledmatrix::RecordingSpiBus> pBus(
+        new ledmatrix::RecordingSpiBus());
+    ledmatrix::RecordingSpiBus* pRawBus = pBus.get();
+    ledmatrix::PiLedMatrix piLedMatrix(
+        std::unique_ptr<ledmatrix::ILedMatrixDriver>(
+            new ledmatrix::Sure3208LedMatrix(true, std::move(pBus))));
+
+    // The matrices are only initialized once: the first batch holds the
+    // init sequences of both screens.
+    std::vector<ledmatrix::RecordedSpiTransfer> transfers =
+        pRawBus->GetTransfers();
+    uint32_t numberOfInitSequences = 0;
+    for (const ledmatrix::RecordedSpiTransfer& transfer : transfers) {
+        // SYS_DYS starts the init sequence.
+        if ((2 == transfer.data.size()) && (0x80 == transfer.data[0]) &&
+            (0x00 == transfer.data[1])) {
+            ++numberOfInitSequences;
+        }
+    }
+    EXPECT_EQ(numberOfInitSequences, 2u);
+}
+
+TEST(PiLedMatrix, WideScreen)
+{
+    std::unique_ptr<ledmatrix::RecordingSpiBus> pBus(
+        new ledmatrix::RecordingSpiBus());
+    ledmatrix::RecordingSpiBus* pRawBus = pBus.get();
+    ledmatrix::PiLedMatrix piLedMatrix(
+        std::unique_ptr<ledmatrix::ILedMatrixDriver>(
+            new ledmatrix::Sure3208LedMatrix(
+                ledmatrix::panel_layout::CreateRow(4), std::move(pBus))));
+    piLedMatrix.Start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    piLedMatrix.Stop();
+
+    // The clock is centered on the four screens: it only lights the two in
+    // the middle.
+    bool isLit[4];
+    for (int channel = 0; channel < 4; ++channel) {
+        uint8_t columns[ledmatrix::ht1632_encoder::NUMBER_OF_COLUMNS];
+        pRawBus->GetColumns(channel, columns);
+        isLit[channel] = false;
+        for (uint8_t column : columns) {
+            isLit[channel] = isLit[channel] || (0 != column);
+        }
+    }
+    EXPECT_FALSE(isLit[0]);
+    EXPECT_TRUE(isLit[1]);
+    EXPECT_TRUE(isLit[2]);
+    EXPECT_FALSE(isLit[3]);
+}
@@ -0,0 +1,124 @@
+/**
+ * @file ProviderSchedulerTests.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Unit tests for the provider scheduler
+ * @version 0.1
+ * @date 2019-06-20
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "mocks/MockIGraphicsProvider.h"
+#include "src/ProviderScheduler.h"
+
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace {
+
+/**
+ * A provider whose state is set by the test.
+ */
+struct FakeProvider {
+  FakeProvider() : isActive(false), priority(0) {
+    ON_CALL(mock, IsActive())
+        .WillByDefault(::testing::ReturnPointee(&isActive));
+    ON_CALL(mock, GetPriority())
+        .WillByDefault(::testing::ReturnPointee(&priority));
+  }
+
+  NiceMock<ledmatrix::MockIGraphicsProvider> mock;
+  bool isActive;
+  unsigned char priority;
+};
+
+}  // namespace
+
+TEST(ProviderScheduler, Empty) {
+  ledmatrix::ProviderScheduler scheduler;
+  EXPECT_EQ(scheduler.GetSize(), 0);
+  EXPECT_EQ(scheduler.GetTop(), 0);
+  EXPECT_EQ(scheduler.GetNumberOfActiveProviders(), 0);
+}
+
+TEST(ProviderScheduler, ActiveFirstThenPriority) {
+  FakeProvider providers[3];
+  providers[0].isActive = true;
+  providers[0].priority = 1;
+  providers[1].priority = 10;
+  providers[2].isActive = true;
+  providers[2].priority = 1;
+
+  ledmatrix::ProviderScheduler scheduler;
+  for (FakeProvider& provider : providers) {
+    scheduler.Add(&provider.mock);
+  }
+  EXPECT_EQ(scheduler.GetSize(), 3);
+  EXPECT_EQ(scheduler.GetProvider(1), &providers[1].mock);
+
+  // The first added one wins a tie.
+  EXPECT_EQ(scheduler.GetTop(), 0);
+  EXPECT_EQ(scheduler.GetNumberOfActiveProviders(), 2);
+
+  // A change is only seen once the provider is updated.
+  providers[1].isActive = true;
+  EXPECT_EQ(scheduler.GetTop(), 0);
+  scheduler.Update(1);
+  EXPECT_EQ(scheduler.GetTop(), 1);
+  EXPECT_EQ(scheduler.GetNumberOfActiveProviders(), 3);
+
+  providers[1].isActive = false;
+  providers[0].isActive = false;
+  providers[2].priority = 2;
+  scheduler.UpdateAll();
+  EXPECT_EQ(scheduler.GetTop(), 2);
+  EXPECT_EQ(scheduler.GetNumberOfActiveProviders(), 1);
+}
+
+TEST(ProviderScheduler, ManyProviders) {
+  const uint16_t numberOfProviders = 50;
+  std::vector<std::unique_ptr<FakeProvider>> providers;
+  ledmatrix::ProviderScheduler scheduler;
+  for (uint16_t i = 0; i < numberOfProviders; ++i) {
+    providers.push_back(std::unique_ptr<FakeProvider>(new FakeProvider()));
+    scheduler.Add(&providers.back()->mock);
+  }
+
+  // Change random providers one at a time, the top is always the one a full
+  // sort would choose.
+  std::mt19937 generator(42);
+  for (int step = 0; step < 1000; ++step) {
+    uint16_t index = generator() % numberOfProviders;
+    providers[index]->isActive = (0 != generator() % 2);
+    providers[index]->priority = static_cast<unsigned char>(generator() % 8);
+    scheduler.Update(index);
+
+    uint16_t expected = 0;
+    uint16_t numberOfActiveProviders = 0;
+    for (uint16_t i = 0; i < numberOfProviders; ++i) {
+      const FakeProvider& candidate = *providers[i];
+      const FakeProvider& best = *providers[expected];
+      if (candidate.isActive) {
+        ++numberOfActiveProviders;
+      }
+      if ((candidate.isActive && !best.isActive) ||
+          ((candidate.isActive == best.isActive) &&
+           (candidate.priority > best.priority))) {
+        expected = i;
+      }
+    }
+    ASSERT_EQ(scheduler.GetTop(), expected);
+    ASSERT_EQ(scheduler.GetNumberOfActiveProviders(), numberOfActiveProviders);
+  }
+}
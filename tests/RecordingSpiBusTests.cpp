@@ -0,0 +1,79 @@
+/**
+ * @file RecordingSpiBusTests.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Unit tests for the recording SPI transport
+ * @version 0.1
+ * @date 2019-06-15
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+#include <memory>
+#include <vector>
+
+#include "src/FixedGraphics.h"
+#include "src/Ht1632Encoder.h"
+#include "src/RecordingSpiBus.h"
+#include "src/Sure3208LedMatrix.h"
+
+TEST(RecordingSpiBus, Record) {
+  ledmatrix::RecordingSpiBus bus;
+  EXPECT_TRUE(bus.Setup(1));
+  EXPECT_FALSE(bus.Setup(ledmatrix::RecordingSpiBus::NUMBER_OF_CHANNELS));
+
+  uint8_t data[3] = {1, 2, 3};
+  ledmatrix::SpiTransfer transfers[2] = {{0, &data[0], 2}, {1, &data[2], 1}};
+  EXPECT_TRUE(bus.WriteBatch(transfers, 2));
+  EXPECT_TRUE(bus.Write(0, &data[1], 1));
+
+  std::vector<ledmatrix::RecordedSpiTransfer> recorded = bus.GetTransfers();
+  ASSERT_EQ(recorded.size(), 3u);
+  EXPECT_EQ(recorded[0].batch, 0u);
+  EXPECT_EQ(recorded[0].channel, 0);
+  EXPECT_EQ(recorded[0].data, std::vector<uint8_t>({1, 2}));
+  EXPECT_EQ(recorded[1].batch, 0u);
+  EXPECT_EQ(recorded[1].channel, 1);
+  EXPECT_EQ(recorded[1].time, recorded[0].time);
+  EXPECT_EQ(recorded[2].batch, 1u);
+  EXPECT_GE(recorded[2].time, recorded[1].time);
+
+  bus.ClearTransfers();
+  EXPECT_TRUE(bus.GetTransfers().empty());
+}
+
+TEST(RecordingSpiBus, SimulatedScreens) {
+  std::unique_ptr<ledmatrix::RecordingSpiBus> pBus(
+      new ledmatrix::RecordingSpiBus());
+  ledmatrix::RecordingSpiBus* pRawBus = pBus.get();
+  ledmatrix::Sure3208LedMatrix matrix(true, std::move(pBus));
+  ledmatrix::FixedGraphics<64, 8> graphics;
+
+  // Whatever the driver sends (whole screens or bursts), the simulated
+  // screens show the graphics.
+  uint8_t expected[64];
+  uint8_t columns[ledmatrix::ht1632_encoder::NUMBER_OF_COLUMNS];
+  for (uint16_t step = 0; step < 100; ++step) {
+    uint16_t x = (step * 7) % 64;
+    graphics.SetPixel(x, step % 8, 0 != (step % 3));
+    matrix.WriteIGraphics(graphics);
+    graphics.ClearDirtyColumns();
+    graphics.ReadColumns(0, 0, expected, 64);
+    for (int channel = 0; channel < 2; ++channel) {
+      pRawBus->GetColumns(channel, columns);
+      ASSERT_EQ(memcmp(columns, expected + 32 * channel, sizeof(columns)), 0);
+    }
+  }
+
+  matrix.Clear();
+  memset(expected, 0, sizeof(expected));
+  pRawBus->GetColumns(1, columns);
+  EXPECT_EQ(memcmp(columns, expected, sizeof(columns)), 0);
+}
@@ -15,13 +15,21 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <thread>
+#include <vector>
 
 #include "mocks/MockIGraphics.h"
+#include "mocks/MockILedMatrixDriver.h"
 #include "mocks/MockIGraphicsProvider.h"
 
+#include "src/FixedGraphics.h"
+#include "src/GrayscaleGraphics.h"
+#include "src/RecordingSpiBus.h"
 #include "src/Runtime.h"
+#include "src/Sure3208LedMatrix.h"
 
 namespace {
 template <typename T, typename... Args>
@@ -55,6 +63,393 @@ TEST(Runtime, StopFailsafe) {
   delete pRuntime;
 }
 
+TEST(Runtime, InjectedHardware) {
+  auto hardware =
+      make_unique<testing::NiceMock<ledmatrix::MockILedMatrixDriver>>();
+  auto pRawHardware = hardware.get();
+  EXPECT_CALL(*pRawHardware, SetBrightness(15)).Times(1);
+
+  auto provider =
+      make_unique<testing::NiceMock<ledmatrix::MockIGraphicsProvider>>();
+  auto pRawProvider = provider.get();
+  ON_CALL(*pRawProvider, IsActive()).WillByDefault(testing::Return(true));
+  ON_CALL(*pRawProvider, GetName())
+      .WillByDefault(testing::Return("Mock provider"));
+  ledmatrix::FixedGraphics<64, 8> graphics;
+  graphics.SetPixel(3, 3, true);
+  ON_CALL(*pRawProvider, GetIGraphics())
+      .WillByDefault(testing::Return(&graphics));
+
+  // The graphics never changes: it is written once.
+  EXPECT_CALL(*pRawHardware, WriteIGraphics(testing::_)).Times(1);
+
+  ledmatrix::Runtime runtime(
+      std::unique_ptr<ledmatrix::ILedMatrixDriver>(std::move(hardware)));
+  runtime.AddGraphicsProvider(std::move(provider));
+  runtime.Start();
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(10 * runtime.DISPLAY_CYCLE_TIME_MILLI));
+  runtime.Stop();
+}
+
+TEST(Runtime, DroppedFrame) {
+  auto hardware =
+      make_unique<testing::NiceMock<ledmatrix::MockILedMatrixDriver>>();
+  auto pRawHardware = hardware.get();
+
+  auto provider =
+      make_unique<testing::NiceMock<ledmatrix::MockIGraphicsProvider>>();
+  auto pRawProvider = provider.get();
+  ON_CALL(*pRawProvider, IsActive()).WillByDefault(testing::Return(true));
+  ledmatrix::FixedGraphics<64, 8> graphics;
+  graphics.SetPixel(3, 3, true);
+  ON_CALL(*pRawProvider, GetIGraphics())
+      .WillByDefault(testing::Return(&graphics));
+
+  // The first write of the graphics is dropped: the same frame is written
+  // again, even though the graphics never changes.
+  std::atomic<unsigned int> numberOfWrites(0);
+  EXPECT_CALL(*pRawHardware, WriteIGraphics(testing::_))
+      .Times(2)
+      .WillRepeatedly(testing::Invoke(
+          [&numberOfWrites](const ledmatrix::IGraphics& graphics) {
+            (void)graphics;
+            ++numberOfWrites;
+          }));
+  ON_CALL(*pRawHardware, IsFrameDropped())
+      .WillByDefault(testing::Invoke(
+          [&numberOfWrites]() { return (1 == numberOfWrites); }));
+
+  ledmatrix::Runtime runtime(std::move(hardware));
+  runtime.AddGraphicsProvider(std::move(provider));
+  runtime.Start();
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(10 * runtime.DISPLAY_CYCLE_TIME_MILLI));
+  runtime.Stop();
+}
+
+TEST(Runtime, DirtyColumns) {
+  auto hardware =
+      make_unique<testing::NiceMock<ledmatrix::MockILedMatrixDriver>>();
+  auto pRawHardware = hardware.get();
+
+  // A single column is modified at every display cycle, in another place.
+  const uint16_t numberOfModifications = 20;
+  auto provider =
+      make_unique<testing::NiceMock<ledmatrix::MockIGraphicsProvider>>();
+  auto pRawProvider = provider.get();
+  ON_CALL(*pRawProvider, IsActive()).WillByDefault(testing::Return(true));
+  ledmatrix::FixedGraphics<64, 8> graphics;
+  ON_CALL(*pRawProvider, GetIGraphics())
+      .WillByDefault(testing::Return(&graphics));
+  ON_CALL(*pRawProvider, ExecuteDisplayCycle(testing::_))
+      .WillByDefault(testing::Invoke([&graphics](uint32_t cycleNumber) {
+        if (cycleNumber < numberOfModifications) {
+          graphics.SetPixel((cycleNumber * 7) % 64, cycleNumber % 8, true);
+        }
+      }));
+
+  // Only the modified columns are copied into the frames: the last one
+  // written must still show every column.
+  std::vector<uint8_t> lastColumns(64);
+  ON_CALL(*pRawHardware, WriteIGraphics(testing::_))
+      .WillByDefault(testing::Invoke(
+          [&lastColumns](const ledmatrix::IGraphics& frame) {
+            frame.ReadColumns(0, 0, lastColumns.data(), 64);
+          }));
+
+  ledmatrix::Runtime runtime(std::move(hardware));
+  runtime.AddGraphicsProvider(std::move(provider));
+  runtime.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(
+      (numberOfModifications + 10) * runtime.DISPLAY_CYCLE_TIME_MILLI));
+  runtime.Stop();
+
+  std::vector<uint8_t> expectedColumns(64);
+  graphics.ReadColumns(0, 0, expectedColumns.data(), 64);
+  EXPECT_EQ(lastColumns, expectedColumns);
+}
+
+TEST(Runtime, GrayscaleProvider) {
+  auto hardware =
+      make_unique<testing::NiceMock<ledmatrix::MockILedMatrixDriver>>();
+  auto pRawHardware = hardware.get();
+
+  auto provider =
+      make_unique<testing::NiceMock<ledmatrix::MockIGraphicsProvider>>();
+  auto pRawProvider = provider.get();
+  ON_CALL(*pRawProvider, IsActive()).WillByDefault(testing::Return(true));
+  ON_CALL(*pRawProvider, GetName())
+      .WillByDefault(testing::Return("Mock provider"));
+  ledmatrix::GrayscaleGraphics<64, 8> graphics;
+  graphics.SetLevel(3, 3, 9);
+  ON_CALL(*pRawProvider, GetIGrayscaleGraphics())
+      .WillByDefault(testing::Return(&graphics));
+
+  // The bit planes are shown again every display cycle, each one with its
+  // own duty.
+  EXPECT_CALL(*pRawHardware, SetBrightness(testing::_))
+      .Times(testing::AnyNumber());
+  EXPECT_CALL(*pRawHardware, SetBrightness(15)).Times(testing::AtLeast(4));
+  EXPECT_CALL(*pRawHardware, SetBrightness(1)).Times(testing::AtLeast(3));
+  EXPECT_CALL(*pRawHardware, WriteIGraphics(testing::_))
+      .Times(testing::AtLeast(12));
+
+  ledmatrix::Runtime runtime(
+      std::unique_ptr<ledmatrix::ILedMatrixDriver>(std::move(hardware)));
+  runtime.AddGraphicsProvider(std::move(provider));
+  runtime.Start();
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(10 * runtime.DISPLAY_CYCLE_TIME_MILLI));
+  runtime.Stop();
+}
+
+TEST(Runtime, GrayscaleProviderOnWideScreen) {
+  auto hardware =
+      make_unique<testing::NiceMock<ledmatrix::MockILedMatrixDriver>>();
+  auto pRawHardware = hardware.get();
+  ON_CALL(*pRawHardware, GetWidth()).WillByDefault(testing::Return(128));
+  ON_CALL(*pRawHardware, GetFrameWriteTimeMicro())
+      .WillByDefault(testing::Return(4150));
+
+  auto provider =
+      make_unique<testing::NiceMock<ledmatrix::MockIGraphicsProvider>>();
+  auto pRawProvider = provider.get();
+  ON_CALL(*pRawProvider, IsActive()).WillByDefault(testing::Return(true));
+  ledmatrix::GrayscaleGraphics<128, 8> grayscaleGraphics;
+  grayscaleGraphics.SetLevel(3, 3, 9);
+  ON_CALL(*pRawProvider, GetIGrayscaleGraphics())
+      .WillByDefault(testing::Return(&grayscaleGraphics));
+  ledmatrix::FixedGraphics<128, 8> graphics;
+  graphics.SetPixel(3, 3, true);
+  ON_CALL(*pRawProvider, GetIGraphics())
+      .WillByDefault(testing::Return(&graphics));
+
+  // The bit planes of four panels cannot be sent in the 3750 us of a
+  // sub-frame: the single color graphics is written once instead.
+  EXPECT_CALL(*pRawHardware, WriteIGraphics(testing::_)).Times(1);
+
+  ledmatrix::Runtime runtime(
+      std::unique_ptr<ledmatrix::ILedMatrixDriver>(std::move(hardware)));
+  runtime.AddGraphicsProvider(std::move(provider));
+  runtime.Start();
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(10 * runtime.DISPLAY_CYCLE_TIME_MILLI));
+  runtime.Stop();
+}
+
+TEST(Runtime, GrayscaleProviderOnTwoPanels) {
+  auto hardware =
+      make_unique<testing::NiceMock<ledmatrix::MockILedMatrixDriver>>();
+  auto pRawHardware = hardware.get();
+  ON_CALL(*pRawHardware, GetWidth()).WillByDefault(testing::Return(64));
+  ON_CALL(*pRawHardware, GetFrameWriteTimeMicro())
+      .WillByDefault(testing::Return(2075));
+
+  auto provider =
+      make_unique<testing::NiceMock<ledmatrix::MockIGraphicsProvider>>();
+  auto pRawProvider = provider.get();
+  ON_CALL(*pRawProvider, IsActive()).WillByDefault(testing::Return(true));
+  ledmatrix::GrayscaleGraphics<64, 8> grayscaleGraphics;
+  grayscaleGraphics.SetLevel(3, 3, 9);
+  ON_CALL(*pRawProvider, GetIGrayscaleGraphics())
+      .WillByDefault(testing::Return(&grayscaleGraphics));
+  ledmatrix::FixedGraphics<64, 8> graphics;
+  graphics.SetPixel(3, 3, true);
+  ON_CALL(*pRawProvider, GetIGraphics())
+      .WillByDefault(testing::Return(&graphics));
+
+  // Two panels fit in a sub-frame but take more than half of it at the
+  // default SPI clock: the single color graphics is written once instead.
+  EXPECT_CALL(*pRawHardware, WriteIGraphics(testing::_)).Times(1);
+
+  ledmatrix::Runtime runtime(
+      std::unique_ptr<ledmatrix::ILedMatrixDriver>(std::move(hardware)));
+  runtime.AddGraphicsProvider(std::move(provider));
+  runtime.Start();
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(10 * runtime.DISPLAY_CYCLE_TIME_MILLI));
+  runtime.Stop();
+}
+
+TEST(Runtime, GrayscaleProviderOnFastBus) {
+  // At 2 MHz, a frame of two panels takes 259 us: the planes are sent in a
+  // small part of their sub-frame.
+  const uint32_t speeds[] = {ledmatrix::Sure3208LedMatrix::SPI_SPEED_HZ,
+                             2 * 1024 * 1024};
+  uint32_t numberOfCommands[2];
+  for (int i = 0; i < 2; ++i) {
+    std::unique_ptr<ledmatrix::RecordingSpiBus> pBus(
+        new ledmatrix::RecordingSpiBus(speeds[i]));
+    ledmatrix::RecordingSpiBus* pRawBus = pBus.get();
+    ledmatrix::Runtime runtime(std::unique_ptr<ledmatrix::ILedMatrixDriver>(
+        new ledmatrix::Sure3208LedMatrix(true, std::move(pBus))));
+
+    auto provider =
+        make_unique<testing::NiceMock<ledmatrix::MockIGraphicsProvider>>();
+    ON_CALL(*provider, IsActive()).WillByDefault(testing::Return(true));
+    ledmatrix::GrayscaleGraphics<64, 8> grayscaleGraphics;
+    grayscaleGraphics.SetLevel(3, 3, 9);
+    ON_CALL(*provider, GetIGrayscaleGraphics())
+        .WillByDefault(testing::Return(&grayscaleGraphics));
+    ledmatrix::FixedGraphics<64, 8> graphics;
+    graphics.SetPixel(3, 3, true);
+    ON_CALL(*provider, GetIGraphics())
+        .WillByDefault(testing::Return(&graphics));
+
+    runtime.AddGraphicsProvider(std::move(provider));
+    pRawBus->ClearTransfers();
+    runtime.Start();
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(10 * runtime.DISPLAY_CYCLE_TIME_MILLI));
+    runtime.Stop();
+
+    // The duty of every plane is a command on each panel.
+    numberOfCommands[i] = 0;
+    for (const ledmatrix::RecordedSpiTransfer& transfer :
+         pRawBus->GetTransfers()) {
+      if (2 == transfer.data.size()) {
+        ++numberOfCommands[i];
+      }
+    }
+  }
+  EXPECT_LT(numberOfCommands[0], 8u);
+  EXPECT_GE(numberOfCommands[1], 3u * 4u * 2u);
+}
+
+TEST(Runtime, StateChangedProvider) {
+  ledmatrix::Runtime runtime(std::unique_ptr<ledmatrix::ILedMatrixDriver>(
+      new testing::NiceMock<ledmatrix::MockILedMatrixDriver>()));
+  ledmatrix::FixedGraphics<64, 8> graphics;
+
+  auto providerLowPriority =
+      make_unique<testing::NiceMock<ledmatrix::MockIGraphicsProvider>>();
+  auto pRawProviderLowPriority = providerLowPriority.get();
+  ON_CALL(*pRawProviderLowPriority, IsActive())
+      .WillByDefault(testing::Return(true));
+  ON_CALL(*pRawProviderLowPriority, GetPriority())
+      .WillByDefault(testing::Return(1));
+  ON_CALL(*pRawProviderLowPriority, CanBePreampted())
+      .WillByDefault(testing::Return(true));
+  ON_CALL(*pRawProviderLowPriority, GetIGraphics())
+      .WillByDefault(testing::Return(&graphics));
+
+  std::atomic<bool> isHighPriorityActive(false);
+  auto providerHighPriority =
+      make_unique<testing::NiceMock<ledmatrix::MockIGraphicsProvider>>();
+  auto pRawProviderHighPriority = providerHighPriority.get();
+  ON_CALL(*pRawProviderHighPriority, IsActive())
+      .WillByDefault(testing::Invoke(
+          [&isHighPriorityActive]() { return (isHighPriorityActive.load()); }));
+  ON_CALL(*pRawProviderHighPriority, GetPriority())
+      .WillByDefault(testing::Return(10));
+  ON_CALL(*pRawProviderHighPriority, GetIGraphics())
+      .WillByDefault(testing::Return(&graphics));
+
+  runtime.AddGraphicsProvider(std::move(providerLowPriority));
+  runtime.AddGraphicsProvider(std::move(providerHighPriority));
+  runtime.Start();
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(10 * runtime.DISPLAY_CYCLE_TIME_MILLI));
+
+  // The high priority provider is displayed long before the next compute
+  // cycle.
+  EXPECT_CALL(*pRawProviderHighPriority, ExecuteDisplayCycle(testing::_))
+      .Times(testing::AtLeast(1));
+  isHighPriorityActive = true;
+  runtime.NotifyStateChanged();
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(10 * runtime.DISPLAY_CYCLE_TIME_MILLI));
+  runtime.Stop();
+}
+
+TEST(Runtime, ProvidersAddedWhileStarted) {
+  ledmatrix::Runtime runtime(std::unique_ptr<ledmatrix::ILedMatrixDriver>(
+      new testing::NiceMock<ledmatrix::MockILedMatrixDriver>()));
+  ledmatrix::FixedGraphics<64, 8> graphics;
+  runtime.Start();
+
+  // Every provider is added while the compute thread may read the others.
+  for (unsigned char priority = 1; priority <= 8; ++priority) {
+    auto provider =
+        make_unique<testing::NiceMock<ledmatrix::MockIGraphicsProvider>>();
+    ON_CALL(*provider, IsActive()).WillByDefault(testing::Return(true));
+    ON_CALL(*provider, GetPriority()).WillByDefault(testing::Return(priority));
+    ON_CALL(*provider, CanBePreampted()).WillByDefault(testing::Return(true));
+    ON_CALL(*provider, GetIGraphics())
+        .WillByDefault(testing::Return(&graphics));
+    if (8 == priority) {
+      // The last one has the highest priority and is displayed right away.
+      EXPECT_CALL(*provider, ExecuteDisplayCycle(testing::_))
+          .Times(testing::AtLeast(1));
+    }
+    runtime.AddGraphicsProvider(std::move(provider));
+    std::this_thread::sleep_for(std::chrono::milliseconds(
+        runtime.DISPLAY_CYCLE_TIME_MILLI / 2));
+  }
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(10 * runtime.DISPLAY_CYCLE_TIME_MILLI));
+  runtime.Stop();
+}
+
+TEST(Runtime, StackedPanels) {
+  // Two panels, one above the other.
+  ledmatrix::PanelLayout layout = {{0, 0, 0, ledmatrix::Normal},
+                                   {1, 0, 8, ledmatrix::Normal}};
+  std::unique_ptr<ledmatrix::RecordingSpiBus> pBus(
+      new ledmatrix::RecordingSpiBus());
+  ledmatrix::RecordingSpiBus* pRawBus = pBus.get();
+  ledmatrix::Runtime runtime(std::unique_ptr<ledmatrix::ILedMatrixDriver>(
+      new ledmatrix::Sure3208LedMatrix(layout, std::move(pBus))));
+
+  auto provider =
+      make_unique<testing::NiceMock<ledmatrix::MockIGraphicsProvider>>();
+  ON_CALL(*provider, IsActive()).WillByDefault(testing::Return(true));
+  ledmatrix::FixedGraphics<32, 16> graphics;
+  graphics.SetPixel(1, 2, true);
+  graphics.SetPixel(3, 10, true);
+  ON_CALL(*provider, GetIGraphics()).WillByDefault(testing::Return(&graphics));
+
+  runtime.AddGraphicsProvider(std::move(provider));
+  runtime.Start();
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(10 * runtime.DISPLAY_CYCLE_TIME_MILLI));
+  runtime.Stop();
+
+  // The rows below the first panel are shown by the second one.
+  uint8_t columns[ledmatrix::ht1632_encoder::NUMBER_OF_COLUMNS];
+  pRawBus->GetColumns(0, columns);
+  EXPECT_EQ(columns[1], 0x04);
+  EXPECT_EQ(columns[3], 0x00);
+  pRawBus->GetColumns(1, columns);
+  EXPECT_EQ(columns[1], 0x00);
+  EXPECT_EQ(columns[3], 0x04);
+}
+
+TEST(Runtime, ComputeCycleTime) {
+  // A provider computing every 50 ms.
+  class FastProvider
+      : public testing::NiceMock<ledmatrix::MockIGraphicsProvider> {
+   public:
+    virtual uint32_t GetComputeCycleTimeMilli() const { return (50); }
+  };
+
+  ledmatrix::Runtime runtime(std::unique_ptr<ledmatrix::ILedMatrixDriver>(
+      new testing::NiceMock<ledmatrix::MockILedMatrixDriver>()));
+  auto fastProvider = make_unique<FastProvider>();
+  auto slowProvider =
+      make_unique<testing::NiceMock<ledmatrix::MockIGraphicsProvider>>();
+  EXPECT_CALL(*fastProvider, ExecuteComputeCycle(testing::_))
+      .Times(testing::Between(8, 12));
+  EXPECT_CALL(*slowProvider, ExecuteComputeCycle(testing::_)).Times(1);
+
+  runtime.AddGraphicsProvider(std::move(fastProvider));
+  runtime.AddGraphicsProvider(std::move(slowProvider));
+  runtime.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(480));
+  runtime.Stop();
+}
+
 TEST(Runtime, OneSingleProvider) {
   ledmatrix::Runtime runtime;
 
@@ -147,18 +542,18 @@ TEST(Runtime, TwoProvidersWithPreamption) {
   ledmatrix::Runtime runtime;
 
   // The idea here is to have the high priority provider inactive at the start
-  // and then preampting the low priority provider.
+  // and then preampting the low priority provider. It becomes active after
+  // half a second, and is seen at its next compute cycle (after one second).
+  std::chrono::steady_clock::time_point const activationTime =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
 
   auto providerHighPriority =
       make_unique<testing::NiceMock<ledmatrix::MockIGraphicsProvider>>();
   auto pRawProviderHighPriority = providerHighPriority.get();
-  EXPECT_CALL(*pRawProviderHighPriority, IsActive())
-      .WillOnce(testing::Return(false))
-      .WillOnce(testing::Return(false))
-      .WillOnce(testing::Return(false))
-      .WillOnce(testing::Return(false))
-      .WillOnce(testing::Return(false))
-      .WillRepeatedly(testing::Return(true));
+  ON_CALL(*pRawProviderHighPriority, IsActive())
+      .WillByDefault(testing::Invoke([activationTime]() {
+        return (std::chrono::steady_clock::now() >= activationTime);
+      }));
   ON_CALL(*pRawProviderHighPriority, GetPriority())
       .WillByDefault(testing::Return(10));
   ON_CALL(*pRawProviderHighPriority, GetName())
@@ -211,3 +606,79 @@ TEST(Runtime, TwoProvidersWithPreamption) {
 
   runtime.Stop();
 }
+
+TEST(Runtime, ProviderSwitchStress) {
+  std::unique_ptr<ledmatrix::RecordingSpiBus> pBus(
+      new ledmatrix::RecordingSpiBus());
+  ledmatrix::RecordingSpiBus* pRawBus = pBus.get();
+  ledmatrix::Runtime runtime(std::unique_ptr<ledmatrix::ILedMatrixDriver>(
+      new ledmatrix::Sure3208LedMatrix(true, std::move(pBus))));
+
+  // Only one provider is active at a time. Each one moves a pixel at every
+  // display cycle, so that a new frame is sent at every display cycle
+  // whatever the provider shown.
+  const uint16_t numberOfProviders = 4;
+  std::atomic<uint16_t> activeProvider(0);
+  std::atomic<unsigned int> numberOfDisplayCycles[numberOfProviders];
+  std::vector<ledmatrix::FixedGraphics<64, 8>> graphics(numberOfProviders);
+  for (uint16_t i = 0; i < numberOfProviders; ++i) {
+    numberOfDisplayCycles[i] = 0;
+    auto provider =
+        make_unique<testing::NiceMock<ledmatrix::MockIGraphicsProvider>>();
+    ledmatrix::FixedGraphics<64, 8>* pGraphics = &graphics[i];
+    std::atomic<unsigned int>* pNumberOfDisplayCycles =
+        &numberOfDisplayCycles[i];
+    ON_CALL(*provider, IsActive())
+        .WillByDefault(testing::Invoke(
+            [&activeProvider, i]() { return (activeProvider.load() == i); }));
+    ON_CALL(*provider, CanBePreampted()).WillByDefault(testing::Return(true));
+    ON_CALL(*provider, GetIGraphics())
+        .WillByDefault(testing::Return(pGraphics));
+    ON_CALL(*provider, ExecuteDisplayCycle(testing::_))
+        .WillByDefault(testing::Invoke(
+            [pGraphics, pNumberOfDisplayCycles, i](unsigned int cycleNumber) {
+              pGraphics->Reset();
+              pGraphics->SetPixel(cycleNumber % 64, i, true);
+              ++(*pNumberOfDisplayCycles);
+            }));
+    runtime.AddGraphicsProvider(std::move(provider));
+  }
+
+  // Switch to another provider every few milliseconds, much faster than the
+  // display cycle.
+  runtime.Start();
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(5 * runtime.DISPLAY_CYCLE_TIME_MILLI));
+  pRawBus->ClearTransfers();
+  std::chrono::steady_clock::time_point const end =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(1000);
+  unsigned int numberOfSwitches = 0;
+  while (std::chrono::steady_clock::now() < end) {
+    activeProvider = (activeProvider + 1) % numberOfProviders;
+    runtime.NotifyStateChanged();
+    ++numberOfSwitches;
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  runtime.Stop();
+
+  for (uint16_t i = 0; i < numberOfProviders; ++i) {
+    EXPECT_GT(numberOfDisplayCycles[i], 0u);
+  }
+
+  // The display thread never waits for the switches: the time between two
+  // batches stays close to the display cycle.
+  std::vector<ledmatrix::RecordedSpiTransfer> transfers =
+      pRawBus->GetTransfers();
+  ASSERT_FALSE(transfers.empty());
+  std::chrono::steady_clock::duration worstInterval =
+      std::chrono::steady_clock::duration::zero();
+  for (size_t i = 1; i < transfers.size(); ++i) {
+    worstInterval =
+        std::max(worstInterval, transfers[i].time - transfers[i - 1].time);
+  }
+  int64_t worstIntervalMicro =
+      std::chrono::duration_cast<std::chrono::microseconds>(worstInterval)
+          .count();
+  EXPECT_LT(worstIntervalMicro, 4 * runtime.DISPLAY_CYCLE_TIME_MILLI * 1000)
+      << "after " << numberOfSwitches << " switches";
+}
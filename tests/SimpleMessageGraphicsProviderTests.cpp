@@ -103,6 +103,37 @@ TEST(SimpleMessageGraphicsProvider, SingleMessage) {
   EXPECT_FALSE(messageProvider.IsActive());
 }
 
+TEST(SimpleMessageGraphicsProvider, StateChanged) {
+  auto mockGraphicsFactory =
+      std::unique_ptr<testing::NiceMock<ledmatrix::MockGraphicsFactory>>(
+          new testing::NiceMock<ledmatrix::MockGraphicsFactory>());
+  auto mockGraphics =
+      std::unique_ptr<testing::NiceMock<ledmatrix::MockIGraphics>>(
+          new testing::NiceMock<ledmatrix::MockIGraphics>());
+  const uint16_t mockGraphicsWidth = 25;
+  ON_CALL(*mockGraphicsFactory, GetIGraphics())
+      .WillByDefault(testing::Return(testing::ByMove(std::move(mockGraphics))));
+  ledmatrix::SimpleMessageGraphicsProvider messageProvider(
+      std::move(mockGraphicsFactory), mockGraphicsWidth);
+  unsigned int numberOfStateChanges = 0;
+  messageProvider.SetStateChangedCallback(
+      [&numberOfStateChanges]() { ++numberOfStateChanges; });
+
+  // A new message is signaled right away.
+  messageProvider.DisplayMessage("a");
+  EXPECT_EQ(numberOfStateChanges, 1u);
+
+  // And so is the end of its animation.
+  uint32_t i = 0;
+  for (; i <= mockGraphicsWidth; i++) {
+    messageProvider.ExecuteDisplayCycle(i);
+    EXPECT_EQ(numberOfStateChanges, 1u);
+  }
+  messageProvider.ExecuteDisplayCycle(i);
+  EXPECT_FALSE(messageProvider.IsActive());
+  EXPECT_EQ(numberOfStateChanges, 2u);
+}
+
 TEST(SimpleMessageGraphicsProvider, LoadTest) {
   auto mockGraphicsFactory =
       std::unique_ptr<testing::NiceMock<ledmatrix::MockGraphicsFactory>>(
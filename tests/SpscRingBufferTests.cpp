@@ -0,0 +1,96 @@
+/**
+ * @file SpscRingBufferTests.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Unit tests for the single producer single consumer queue
+ * @version 0.1
+ * @date 2019-06-14
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <array>
+#include <thread>
+
+#include "src/SpscRingBuffer.h"
+
+TEST(SpscRingBuffer, PushPop) {
+  ledmatrix::SpscRingBuffer<int, 4> buffer;
+
+  // Nothing pushed yet
+  EXPECT_TRUE(buffer.IsEmpty());
+  EXPECT_EQ(buffer.GetReadSlot(), nullptr);
+  EXPECT_EQ(buffer.GetFreeSlots(), 4);
+
+  // Fill the queue
+  for (int i = 0; i < 4; ++i) {
+    int* pSlot = buffer.GetWriteSlot();
+    ASSERT_NE(pSlot, nullptr);
+    *pSlot = i;
+    buffer.Push();
+  }
+  EXPECT_FALSE(buffer.IsEmpty());
+  EXPECT_EQ(buffer.GetFreeSlots(), 0);
+  EXPECT_EQ(buffer.GetWriteSlot(), nullptr);
+
+  // The elements come out in order, and make some room.
+  ASSERT_NE(buffer.GetReadSlot(), nullptr);
+  EXPECT_EQ(*buffer.GetReadSlot(), 0);
+  buffer.Pop();
+  EXPECT_EQ(buffer.GetFreeSlots(), 1);
+  *buffer.GetWriteSlot() = 4;
+  buffer.Push();
+  for (int i = 1; i <= 4; ++i) {
+    ASSERT_NE(buffer.GetReadSlot(), nullptr);
+    EXPECT_EQ(*buffer.GetReadSlot(), i);
+    buffer.Pop();
+  }
+  EXPECT_TRUE(buffer.IsEmpty());
+  EXPECT_EQ(buffer.GetReadSlot(), nullptr);
+}
+
+TEST(SpscRingBuffer, ConcurrentProducerConsumer) {
+  typedef std::array<uint32_t, 64> Element;
+  ledmatrix::SpscRingBuffer<Element, 8> buffer;
+  const uint32_t numberOfElements = 10000;
+
+  // Every element is filled with its number: a torn element would contain
+  // two different numbers.
+  std::thread producer([&]() {
+    for (uint32_t i = 1; i <= numberOfElements; ++i) {
+      Element* pSlot = buffer.GetWriteSlot();
+      while (nullptr == pSlot) {
+        std::this_thread::yield();
+        pSlot = buffer.GetWriteSlot();
+      }
+      pSlot->fill(i);
+      buffer.Push();
+    }
+  });
+
+  uint32_t lastElement = 0;
+  bool bTorn = false;
+  while (lastElement < numberOfElements) {
+    const Element* pSlot = buffer.GetReadSlot();
+    if (pSlot) {
+      for (uint32_t value : *pSlot) {
+        bTorn = bTorn || (value != (*pSlot)[0]);
+      }
+      // Nothing is skipped
+      ASSERT_EQ((*pSlot)[0], lastElement + 1);
+      lastElement = (*pSlot)[0];
+      buffer.Pop();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+
+  EXPECT_FALSE(bTorn);
+  EXPECT_TRUE(buffer.IsEmpty());
+}
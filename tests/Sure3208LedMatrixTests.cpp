@@ -0,0 +1,311 @@
+/**
+ * @file Sure3208LedMatrixTests.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Unit tests for the Sure 3208 driver
+ * @version 0.1
+ * @date 2019-06-13
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "mocks/MockISpiBus.h"
+#include "src/FixedGraphics.h"
+#include "src/RecordingSpiBus.h"
+#include "src/Sure3208LedMatrix.h"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace {
+
+/**
+ * Every call to WriteBatch, with a copy of the sent messages.
+ */
+struct Batch {
+  std::vector<int> channels;
+  std::vector<std::vector<uint8_t>> messages;
+};
+
+/**
+ * Create a mock bus recording its batches in \a batches.
+ */
+std::unique_ptr<ledmatrix::ISpiBus> CreateRecordingBus(
+    std::vector<Batch>* batches) {
+  std::unique_ptr<NiceMock<ledmatrix::MockISpiBus>> pBus(
+      new NiceMock<ledmatrix::MockISpiBus>());
+  ON_CALL(*pBus, Setup(_)).WillByDefault(Return(true));
+  ON_CALL(*pBus, GetNumberOfChannels()).WillByDefault(Return(5));
+  ON_CALL(*pBus, WriteBatch(_, _))
+      .WillByDefault(Invoke([batches](const ledmatrix::SpiTransfer* transfers,
+                                      uint16_t count) {
+        Batch batch;
+        for (uint16_t i = 0; i < count; ++i) {
+          batch.channels.push_back(transfers[i].channel);
+          batch.messages.push_back(std::vector<uint8_t>(
+              transfers[i].data, transfers[i].data + transfers[i].size));
+        }
+        batches->push_back(batch);
+        return (true);
+      }));
+  return (pBus);
+}
+
+}  // namespace
+
+TEST(Sure3208LedMatrix, Init) {
+  std::vector<Batch> batches;
+  ledmatrix::Sure3208LedMatrix matrix(true, CreateRecordingBus(&batches));
+  EXPECT_TRUE(matrix.IsInitialized());
+
+  // One batch for the init sequences of both screens, then one to clear
+  // them.
+  ASSERT_EQ(batches.size(), 2u);
+  const Batch& init = batches[0];
+  ASSERT_EQ(init.messages.size(), 12u);
+  for (uint16_t i = 0; i < init.messages.size(); ++i) {
+    EXPECT_EQ(init.channels[i], i / 6);
+    ASSERT_EQ(init.messages[i].size(), 2u);
+    // Every command starts with 100.
+    EXPECT_EQ(init.messages[i][0] & 0xe0, 0x80);
+  }
+  // SYS_DYS first, BLINK_OFF last.
+  EXPECT_EQ(init.messages[0][0], 0x80);
+  EXPECT_EQ(init.messages[0][1], 0x00);
+  EXPECT_EQ(init.messages[5][0], 0x81);
+  EXPECT_EQ(init.messages[5][1], 0x00);
+
+  const Batch& clear = batches[1];
+  ASSERT_EQ(clear.messages.size(), 2u);
+  for (int channel = 0; channel < 2; ++channel) {
+    EXPECT_EQ(clear.channels[channel], channel);
+    EXPECT_EQ(clear.messages[channel].size(),
+              ledmatrix::ht1632_encoder::FRAME_SIZE);
+  }
+
+  // Commands are sent to every screen at once.
+  batches.clear();
+  matrix.SetBrightness(15);
+  ASSERT_EQ(batches.size(), 1u);
+  ASSERT_EQ(batches[0].messages.size(), 2u);
+  EXPECT_EQ(batches[0].messages[0][0], 0x95);
+  EXPECT_EQ(batches[0].messages[0][1], 0xe0);
+  EXPECT_EQ(batches[0].channels[1], 1);
+  EXPECT_EQ(batches[0].messages[1], batches[0].messages[0]);
+}
+
+TEST(Sure3208LedMatrix, BothScreensAreWrittenAtOnce) {
+  std::vector<Batch> batches;
+  ledmatrix::Sure3208LedMatrix matrix(true, CreateRecordingBus(&batches));
+  ledmatrix::FixedGraphics<64, 8> graphics;
+
+  batches.clear();
+  graphics.SetPixel(10, 3, true);
+  graphics.SetPixel(40, 3, true);
+  matrix.WriteIGraphics(graphics);
+  ASSERT_EQ(batches.size(), 1u);
+  ASSERT_EQ(batches[0].messages.size(), 2u);
+  EXPECT_EQ(batches[0].channels[0], 0);
+  EXPECT_EQ(batches[0].channels[1], 1);
+}
+
+TEST(Sure3208LedMatrix, OnlyTheModifiedAddressesAreSent) {
+  std::vector<Batch> batches;
+  ledmatrix::Sure3208LedMatrix matrix(true, CreateRecordingBus(&batches));
+  ledmatrix::FixedGraphics<64, 8> graphics;
+
+  // The screens are already blank.
+  batches.clear();
+  matrix.WriteIGraphics(graphics);
+  EXPECT_TRUE(batches.empty());
+
+  // A single pixel is a short burst on its screen only.
+  graphics.ClearDirtyColumns();
+  graphics.SetPixel(40, 3, true);
+  matrix.WriteIGraphics(graphics);
+  ASSERT_EQ(batches.size(), 1u);
+  ASSERT_EQ(batches[0].messages.size(), 1u);
+  EXPECT_EQ(batches[0].channels[0], 1);
+  EXPECT_LT(batches[0].messages[0].size(),
+            ledmatrix::ht1632_encoder::FRAME_SIZE);
+
+  // Writing the same content again sends nothing.
+  batches.clear();
+  graphics.ClearDirtyColumns();
+  graphics.SetPixel(40, 3, true);
+  matrix.WriteIGraphics(graphics);
+  EXPECT_TRUE(batches.empty());
+}
+
+TEST(Sure3208LedMatrix, DroppedFramesAreWrittenAgain) {
+  std::vector<Batch> batches;
+  std::unique_ptr<ledmatrix::ISpiBus> pBus = CreateRecordingBus(&batches);
+  ledmatrix::MockISpiBus* pMockBus =
+      static_cast<ledmatrix::MockISpiBus*>(pBus.get());
+  ledmatrix::Sure3208LedMatrix matrix(false, std::move(pBus));
+  ledmatrix::FixedGraphics<32, 8> graphics;
+
+  // The bus drops the frame.
+  EXPECT_CALL(*pMockBus, WriteBatch(_, _)).WillOnce(Return(false));
+  graphics.SetPixel(10, 3, true);
+  matrix.WriteIGraphics(graphics);
+  ::testing::Mock::VerifyAndClearExpectations(pMockBus);
+
+  // The whole screen is written next time, even for a single pixel.
+  batches.clear();
+  graphics.ClearDirtyColumns();
+  graphics.SetPixel(11, 3, true);
+  matrix.WriteIGraphics(graphics);
+  ASSERT_EQ(batches.size(), 1u);
+  ASSERT_EQ(batches[0].messages.size(), 1u);
+  EXPECT_EQ(batches[0].messages[0].size(),
+            ledmatrix::ht1632_encoder::FRAME_SIZE);
+}
+
+TEST(Sure3208LedMatrix, DroppedFramesAreWrittenAgainWithoutChange) {
+  std::vector<Batch> batches;
+  std::unique_ptr<ledmatrix::ISpiBus> pBus = CreateRecordingBus(&batches);
+  ledmatrix::MockISpiBus* pMockBus =
+      static_cast<ledmatrix::MockISpiBus*>(pBus.get());
+  ledmatrix::Sure3208LedMatrix matrix(true, std::move(pBus));
+  ledmatrix::FixedGraphics<64, 8> graphics;
+  EXPECT_FALSE(matrix.IsFrameDropped());
+
+  // The bus drops the frame.
+  EXPECT_CALL(*pMockBus, WriteBatch(_, _)).WillOnce(Return(false));
+  graphics.SetPixel(10, 3, true);
+  matrix.WriteIGraphics(graphics);
+  ::testing::Mock::VerifyAndClearExpectations(pMockBus);
+  EXPECT_TRUE(matrix.IsFrameDropped());
+
+  // The same content is written again: only the screen that missed it
+  // receives it, entirely.
+  batches.clear();
+  graphics.ClearDirtyColumns();
+  matrix.WriteIGraphics(graphics);
+  ASSERT_EQ(batches.size(), 1u);
+  ASSERT_EQ(batches[0].messages.size(), 1u);
+  EXPECT_EQ(batches[0].channels[0], 0);
+  EXPECT_EQ(batches[0].messages[0].size(),
+            ledmatrix::ht1632_encoder::FRAME_SIZE);
+  EXPECT_FALSE(matrix.IsFrameDropped());
+}
+
+TEST(Sure3208LedMatrix, FrameWriteTime) {
+  // A frame is 34 bytes, 1.04 ms at 256 kHz for every panel.
+  const uint32_t speedHz = ledmatrix::Sure3208LedMatrix::SPI_SPEED_HZ;
+  ledmatrix::Sure3208LedMatrix doubleMatrix(
+      true, std::unique_ptr<ledmatrix::ISpiBus>(
+                new ledmatrix::RecordingSpiBus(speedHz)));
+  EXPECT_EQ(doubleMatrix.GetFrameWriteTimeMicro(), 2075);
+  ledmatrix::Sure3208LedMatrix rowMatrix(
+      ledmatrix::panel_layout::CreateRow(4),
+      std::unique_ptr<ledmatrix::ISpiBus>(
+          new ledmatrix::RecordingSpiBus(speedHz)));
+  EXPECT_EQ(rowMatrix.GetFrameWriteTimeMicro(), 4150);
+
+  // The time follows the clock of the bus.
+  ledmatrix::Sure3208LedMatrix fastMatrix(
+      true, std::unique_ptr<ledmatrix::ISpiBus>(
+                new ledmatrix::RecordingSpiBus(8 * speedHz)));
+  EXPECT_EQ(fastMatrix.GetFrameWriteTimeMicro(), 259);
+  ledmatrix::Sure3208LedMatrix instantMatrix(
+      true,
+      std::unique_ptr<ledmatrix::ISpiBus>(new ledmatrix::RecordingSpiBus()));
+  EXPECT_EQ(instantMatrix.GetFrameWriteTimeMicro(), 0);
+}
+
+TEST(Sure3208LedMatrix, PanelsWithoutChannel) {
+  // The bus has five channels: a row of seven panels is refused.
+  std::unique_ptr<ledmatrix::RecordingSpiBus> pBus(
+      new ledmatrix::RecordingSpiBus());
+  ledmatrix::RecordingSpiBus* pRawBus = pBus.get();
+  ledmatrix::Sure3208LedMatrix matrix(ledmatrix::panel_layout::CreateRow(7),
+                                      std::move(pBus));
+  EXPECT_FALSE(matrix.IsInitialized());
+  EXPECT_EQ(matrix.GetWidth(), 0);
+
+  ledmatrix::FixedGraphics<224, 8> graphics;
+  graphics.SetPixel(3, 0, true);
+  matrix.WriteIGraphics(graphics);
+  EXPECT_FALSE(matrix.IsFrameDropped());
+  EXPECT_TRUE(pRawBus->GetTransfers().empty());
+}
+
+TEST(Sure3208LedMatrix, PanelsSharingAChannel) {
+  ledmatrix::PanelLayout layout = {{0, 0, 0, ledmatrix::Normal},
+                                   {0, 32, 0, ledmatrix::Normal}};
+  std::unique_ptr<ledmatrix::RecordingSpiBus> pBus(
+      new ledmatrix::RecordingSpiBus());
+  ledmatrix::RecordingSpiBus* pRawBus = pBus.get();
+  ledmatrix::Sure3208LedMatrix matrix(layout, std::move(pBus));
+  EXPECT_FALSE(matrix.IsInitialized());
+  EXPECT_EQ(matrix.GetWidth(), 0);
+  EXPECT_TRUE(pRawBus->GetTransfers().empty());
+}
+
+TEST(Sure3208LedMatrix, PanelLayout) {
+  // Two rows of two panels, the bottom right one being upside down.
+  ledmatrix::PanelLayout layout = {{0, 0, 0, ledmatrix::Normal},
+                                   {1, 32, 0, ledmatrix::Normal},
+                                   {2, 0, 8, ledmatrix::Normal},
+                                   {3, 32, 8, ledmatrix::Rotated180}};
+  std::unique_ptr<ledmatrix::RecordingSpiBus> pBus(
+      new ledmatrix::RecordingSpiBus());
+  ledmatrix::RecordingSpiBus* pRawBus = pBus.get();
+  ledmatrix::Sure3208LedMatrix matrix(layout, std::move(pBus));
+  EXPECT_EQ(matrix.GetWidth(), 64);
+  EXPECT_EQ(matrix.GetHeight(), 16);
+
+  ledmatrix::FixedGraphics<64, 16> graphics;
+  graphics.SetPixel(1, 2, true);
+  graphics.SetPixel(33, 3, true);
+  graphics.SetPixel(2, 9, true);
+  graphics.SetPixel(34, 10, true);
+  matrix.WriteIGraphics(graphics);
+
+  uint8_t columns[ledmatrix::ht1632_encoder::NUMBER_OF_COLUMNS];
+  pRawBus->GetColumns(0, columns);
+  EXPECT_EQ(columns[1], 0x04);
+  pRawBus->GetColumns(1, columns);
+  EXPECT_EQ(columns[1], 0x08);
+  pRawBus->GetColumns(2, columns);
+  EXPECT_EQ(columns[2], 0x02);
+  // Column 34, row 10 is column 29, row 5 of the upside down panel.
+  pRawBus->GetColumns(3, columns);
+  EXPECT_EQ(columns[29], 0x20);
+  EXPECT_EQ(columns[2], 0x00);
+
+  // Scrolling keeps the upside down panel right.
+  for (uint16_t x = 0; x < 64; x += 3) {
+    graphics.SetPixel(x, 8 + x % 8, true);
+  }
+  for (uint16_t step = 0; step < 40; ++step) {
+    graphics.ClearDirtyColumns();
+    graphics.Shift(ledmatrix::Left, 1);
+    matrix.WriteIGraphics(graphics);
+    uint8_t expected[ledmatrix::ht1632_encoder::NUMBER_OF_COLUMNS];
+    graphics.ReadColumns(32, 8, expected, 32);
+    pRawBus->GetColumns(3, columns);
+    for (uint16_t x = 0; x < 32; ++x) {
+      uint8_t mirrored = 0;
+      for (uint16_t y = 0; y < 8; ++y) {
+        if (expected[31 - x] & (0x1 << y)) {
+          mirrored |= (0x80 >> y);
+        }
+      }
+      ASSERT_EQ(columns[x], mirrored);
+    }
+  }
+}
@@ -0,0 +1,86 @@
+/**
+ * @file TripleBufferTests.cpp
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Unit tests for the TripleBuffer class template
+ * @version 0.1
+ * @date 2019-06-11
+ *
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com).
+ * All rights reserved. Licensed under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <array>
+#include <thread>
+
+#include "src/TripleBuffer.h"
+
+TEST(TripleBuffer, PublishConsume) {
+  ledmatrix::TripleBuffer<int> buffer;
+
+  // Nothing published yet
+  EXPECT_FALSE(buffer.Consume());
+
+  buffer.GetBackBuffer() = 1;
+  buffer.Publish();
+  EXPECT_TRUE(buffer.Consume());
+  EXPECT_EQ(buffer.GetFrontBuffer(), 1);
+  // The frame is only consumed once
+  EXPECT_FALSE(buffer.Consume());
+  EXPECT_EQ(buffer.GetFrontBuffer(), 1);
+
+  // Only the latest frame is consumed
+  buffer.GetBackBuffer() = 2;
+  buffer.Publish();
+  buffer.GetBackBuffer() = 3;
+  buffer.Publish();
+  EXPECT_TRUE(buffer.Consume());
+  EXPECT_EQ(buffer.GetFrontBuffer(), 3);
+  EXPECT_FALSE(buffer.Consume());
+
+  // The producer never draws in the front buffer
+  buffer.GetBackBuffer() = 4;
+  EXPECT_EQ(buffer.GetFrontBuffer(), 3);
+  buffer.Publish();
+  buffer.GetBackBuffer() = 5;
+  EXPECT_EQ(buffer.GetFrontBuffer(), 3);
+  EXPECT_TRUE(buffer.Consume());
+  EXPECT_EQ(buffer.GetFrontBuffer(), 4);
+}
+
+TEST(TripleBuffer, ConcurrentProducerConsumer) {
+  typedef std::array<uint32_t, 64> Frame;
+  ledmatrix::TripleBuffer<Frame> buffer;
+  const uint32_t numberOfFrames = 100000;
+
+  // Every frame is filled with its number: a torn frame would contain two
+  // different numbers.
+  std::thread producer([&]() {
+    for (uint32_t i = 1; i <= numberOfFrames; ++i) {
+      buffer.GetBackBuffer().fill(i);
+      buffer.Publish();
+    }
+  });
+
+  uint32_t lastFrame = 0;
+  bool bTorn = false;
+  while (lastFrame < numberOfFrames) {
+    if (buffer.Consume()) {
+      const Frame& frame = buffer.GetFrontBuffer();
+      for (uint32_t value : frame) {
+        bTorn = bTorn || (value != frame[0]);
+      }
+      // Frames may be skipped but never go backward
+      EXPECT_GT(frame[0], lastFrame);
+      lastFrame = frame[0];
+    }
+  }
+  producer.join();
+
+  EXPECT_FALSE(bTorn);
+  EXPECT_EQ(lastFrame, numberOfFrames);
+}
@@ -27,6 +27,7 @@ class MockIGraphicsProvider : public IGraphicsProvider {
   MOCK_METHOD1(ExecuteComputeCycle, void(const uint32_t cycleNumber));
   MOCK_METHOD1(ExecuteDisplayCycle, void(const uint32_t cycleNumber));
   MOCK_CONST_METHOD0(GetIGraphics, IGraphics*());
+  MOCK_CONST_METHOD0(GetIGrayscaleGraphics, IGrayscaleGraphics*());
   MOCK_CONST_METHOD0(IsActive, bool());
   MOCK_CONST_METHOD0(GetPriority, unsigned char());
   MOCK_CONST_METHOD0(CanBePreampted, bool());
@@ -0,0 +1,41 @@
+/**
+ * @file MockILedMatrixDriver.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Mock for the ILedMatrixDriver class.
+ * @version 0.1
+ * @date 2019-06-15
+ * 
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com). All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ */
+#pragma once
+
+#include <gmock/gmock.h>
+#include "src/ILedMatrixDriver.h"
+
+namespace ledmatrix {
+
+class MockILedMatrixDriver : public ILedMatrixDriver {
+ public:
+  MOCK_METHOD0(Clear,
+      void());
+  MOCK_METHOD1(WriteIGraphics,
+      void(const IGraphics& graphics));
+  MOCK_CONST_METHOD0(IsFrameDropped,
+      bool());
+  MOCK_METHOD1(SetBrightness,
+      void(unsigned char level));
+  MOCK_METHOD1(Blink,
+      void(bool on));
+  MOCK_CONST_METHOD0(GetWidth,
+      uint16_t());
+  MOCK_CONST_METHOD0(GetHeight,
+      uint16_t());
+  MOCK_CONST_METHOD0(GetFrameWriteTimeMicro,
+      uint32_t());
+};
+
+}  // namespace ledmatrix
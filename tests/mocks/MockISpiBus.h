@@ -0,0 +1,33 @@
+/**
+ * @file MockISpiBus.h
+ * @author Daniel Peppicelli (daniel.peppicelli@gmail.com)
+ * @brief Mock for the ISpiBus class.
+ * @version 0.1
+ * @date 2019-06-13
+ * 
+ * @copyright Copyright 2019 Daniel Peppicelli (daniel.peppicelli@gmail.com). All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ */
+#pragma once
+
+#include <gmock/gmock.h>
+#include "src/ISpiBus.h"
+
+namespace ledmatrix {
+
+class MockISpiBus : public ISpiBus {
+ public:
+  MOCK_METHOD1(Setup,
+      bool(int channel));
+  MOCK_CONST_METHOD0(GetNumberOfChannels,
+      int());
+  MOCK_CONST_METHOD0(GetSpeedHz,
+      uint32_t());
+  MOCK_METHOD2(WriteBatch,
+      bool(const SpiTransfer* transfers, uint16_t count));
+};
+
+}  // namespace ledmatrix